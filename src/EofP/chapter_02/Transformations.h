@@ -1,8 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace EofP {
 
@@ -22,4 +28,168 @@ template <typename T>
 T EuclideanNorm(T x, T y, T z) {
     return std::sqrt(x * x + y * y + z * z);
 }
+
+// Orbit structure of every point of a small domain
+
+// Unsigned integers of width bits (1 to 64) packed in 64 bit words
+struct PackedArray {
+    PackedArray(std::uint64_t n, unsigned width)
+          : n_(n), width_(width), words_((n * width + 63) / 64 + 1, 0) {}
+    [[nodiscard]] std::uint64_t Size() const {
+        return n_;
+    }
+    [[nodiscard]] unsigned Width() const {
+        return width_;
+    }
+    [[nodiscard]] std::uint64_t Get(std::uint64_t i) const {
+        const std::uint64_t bit = i * width_;
+        const std::uint64_t w = bit / 64;
+        const unsigned offset = bit % 64;
+        std::uint64_t x = words_[w] >> offset;
+        if (offset + width_ > 64)
+            x |= words_[w + 1] << (64 - offset);
+        return x & Mask();
+    }
+    void Set(std::uint64_t i, std::uint64_t x) {
+        const std::uint64_t bit = i * width_;
+        const std::uint64_t w = bit / 64;
+        const unsigned offset = bit % 64;
+        words_[w] = (words_[w] & ~(Mask() << offset)) | (x << offset);
+        if (offset + width_ > 64)
+            words_[w + 1] = (words_[w + 1] & ~(Mask() >> (64 - offset))) | (x >> (64 - offset));
+    }
+
+private:
+    [[nodiscard]] std::uint64_t Mask() const {
+        return width_ == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width_) - 1;
+    }
+
+    std::uint64_t n_;
+    unsigned width_;
+    std::vector<std::uint64_t> words_;
+};
+
+// Decomposition of the functional graph of a transformation over [0, n):
+// for each point its handle size (distance to the cycle of its orbit), the
+// id of that cycle and the cycle size.
+// f is evaluated once per point, in parallel, and the graph is decomposed
+// with one walk over the successor table: every point is visited once, when
+// its orbit is first followed, and the handle sizes are filled in on the way
+// back, so the whole decomposition is O(n).
+template <typename T>
+struct OrbitTable {
+    static_assert(std::is_unsigned_v<T>, "the domain must be unsigned integers");
+    // the whole domain of T is tabulated by default: for 64 bit T its size
+    // would not fit in n, and no such table fits in memory anyway
+    static_assert(sizeof(T) <= 4, "the domain must be small enough to tabulate");
+
+    template <typename F>
+    explicit OrbitTable(F f, std::uint64_t n = std::uint64_t(std::numeric_limits<T>::max()) + 1,
+          unsigned threads = std::max(1U, std::thread::hardware_concurrency()))
+          : successor_(n), handle_(n, BitWidth(n)), cycle_(n, BitWidth(n)) {
+        // precondition: 0 < n, 0 < threads and f maps [0, n) into [0, n)
+        EvaluateSuccessors(f, threads);
+        Decompose();
+    }
+    [[nodiscard]] std::uint64_t Size() const {
+        return successor_.size();
+    }
+    T Successor(T x) const {
+        return successor_[x];
+    }
+    [[nodiscard]] std::uint64_t HandleSize(T x) const {
+        return handle_.Get(x);
+    }
+    [[nodiscard]] std::uint64_t CycleId(T x) const {
+        return cycle_.Get(x);
+    }
+    [[nodiscard]] std::uint64_t CycleSize(T x) const {
+        return cycle_size_[CycleId(x)];
+    }
+    [[nodiscard]] std::uint64_t CycleCount() const {
+        return cycle_size_.size();
+    }
+    T ConnectionPoint(T x) const {
+        for (std::uint64_t h = HandleSize(x); h != 0; --h)
+            x = successor_[x];
+        return x;
+    }
+
+private:
+    static unsigned BitWidth(std::uint64_t n) {
+        unsigned w = 1;
+        while (w < 64 && (n - 1) >> w != 0)
+            ++w;
+        return w;
+    }
+
+    template <typename F>
+    void EvaluateSuccessors(F& f, unsigned threads) {
+        const std::uint64_t n = successor_.size();
+        const std::uint64_t chunk = (n + threads - 1) / threads;
+        std::vector<std::thread> workers;
+        for (std::uint64_t first = 0; first < n; first += chunk) {
+            const std::uint64_t last = std::min(n, first + chunk);
+            workers.emplace_back([this, &f, first, last]() {
+                for (std::uint64_t x = first; x < last; ++x)
+                    successor_[x] = f(static_cast<T>(x));
+            });
+        }
+        for (auto& w : workers)
+            w.join();
+    }
+
+    void Decompose() {
+        const std::uint64_t n = successor_.size();
+        PackedArray visited(n, 1);
+        PackedArray on_path(n, 1);
+        std::vector<T> path;
+        for (std::uint64_t x = 0; x < n; ++x) {
+            if (visited.Get(x))
+                continue;
+
+            T y = static_cast<T>(x);
+            while (not visited.Get(y)) {
+                visited.Set(y, 1);
+                on_path.Set(y, 1);
+                path.push_back(y);
+                y = successor_[y];
+            }
+
+            std::uint64_t h = 0;
+            std::uint64_t id = 0;
+            if (on_path.Get(y)) {
+                // the walk closed a new cycle: the path from y on
+                id = cycle_size_.size();
+                std::uint64_t size = 0;
+                T z;
+                do {
+                    z = path.back();
+                    path.pop_back();
+                    on_path.Set(z, 0);
+                    handle_.Set(z, 0);
+                    cycle_.Set(z, id);
+                    ++size;
+                } while (z != y);
+                cycle_size_.push_back(size);
+            } else {
+                h = handle_.Get(y);
+                id = cycle_.Get(y);
+            }
+            while (not path.empty()) {
+                const T z = path.back();
+                path.pop_back();
+                on_path.Set(z, 0);
+                ++h;
+                handle_.Set(z, h);
+                cycle_.Set(z, id);
+            }
+        }
+    }
+
+    std::vector<T> successor_;
+    PackedArray handle_;
+    PackedArray cycle_;
+    std::vector<std::uint64_t> cycle_size_;
+};
 }
@@ -1,9 +1,28 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <iterator>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace EofP {
 
+// Hint to bring the cache line of address in before it is dereferenced
+inline void PrefetchAddress(const void* address) {
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
 // Section 6.4
 
 template <typename I, typename P>
@@ -29,6 +48,95 @@ I FindIf(I f, I l, P p) {
     return f;
 }
 
+template <typename I>
+I FindUnguarded(I f, const typename std::iterator_traits<I>::value_type& x) {
+    // precondition: x is reachable from f
+    while (*f != x)
+        ++f;
+    return f;
+}
+
+template <typename I, typename P>
+I FindIfUnguarded(I f, P p) {
+    // precondition: an element satisfying p is reachable from f
+    while (not p(*f))
+        ++f;
+    return f;
+}
+
+// l must be a writable spare slot just past the range: the key is planted
+// there so the loop needs a single comparison per element
+template <typename I>
+I FindSentinel(I f, I l, const typename std::iterator_traits<I>::value_type& x) {
+    typename std::iterator_traits<I>::value_type saved = std::move(*l);
+    *l = x;
+    f = FindUnguarded(f, x);
+    *l = std::move(saved);
+    return f;
+}
+
+template <typename I, typename P>
+I FindIfSentinel(I f, I l, P p, const typename std::iterator_traits<I>::value_type& s) {
+    // precondition: p(s)
+    typename std::iterator_traits<I>::value_type saved = std::move(*l);
+    *l = s;
+    f = FindIfUnguarded(f, p);
+    *l = std::move(saved);
+    return f;
+}
+
+// Range terminated by the first element equal to a sentinel value, as a
+// C string is. The limit is a default constructed iterator and comparing
+// against it compares the current element with the sentinel.
+template <typename I>
+struct SentinelIterator {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::iterator_traits<I>::value_type;
+    using reference = typename std::iterator_traits<I>::reference;
+    using pointer = typename std::iterator_traits<I>::pointer;
+    using difference_type = typename std::iterator_traits<I>::difference_type;
+
+    SentinelIterator()
+          : i_(), s_(), limit_(true) {}
+    SentinelIterator(I i, value_type s)
+          : i_(std::move(i)), s_(std::move(s)), limit_(false) {}
+    reference operator*() const {
+        return *i_;
+    }
+    SentinelIterator& operator++() {
+        ++i_;
+        return *this;
+    }
+    SentinelIterator operator++(int) {
+        SentinelIterator tmp = *this;
+        ++i_;
+        return tmp;
+    }
+    I Base() const {
+        return i_;
+    }
+    [[nodiscard]] friend bool operator==(const SentinelIterator& x, const SentinelIterator& y) {
+        if (x.limit_)
+            return y.limit_ || *y.i_ == y.s_;
+        if (y.limit_)
+            return *x.i_ == x.s_;
+        return x.i_ == y.i_;
+    }
+    [[nodiscard]] friend bool operator!=(const SentinelIterator& x, const SentinelIterator& y) {
+        return not(x == y);
+    }
+
+private:
+    I i_;
+    value_type s_;
+    bool limit_;
+};
+
+template <typename I>
+std::pair<SentinelIterator<I>, SentinelIterator<I>> SentinelRange(I f, typename std::iterator_traits<I>::value_type s) {
+    return std::make_pair(SentinelIterator<I>(std::move(f), std::move(s)), SentinelIterator<I>());
+}
+
 template <typename I, typename P, typename J>
 J CountIf(I f, I l, P p, J j) {
     while (f != l) {
@@ -39,13 +147,215 @@ J CountIf(I f, I l, P p, J j) {
     return j;
 }
 
+// Several counts in a single sweep of the range. The counts are incremented
+// without branches.
+
+template <typename T, typename Ps, typename J, std::size_t K, std::size_t... Is>
+void CountIfEachStep(const T& x, const Ps& ps, std::array<J, K>& j, std::index_sequence<Is...>) {
+    ((j[Is] += static_cast<J>(std::get<Is>(ps)(x) ? 1 : 0)), ...);
+}
+
+// Comparisons with a constant that apply equally to one element and, lane by
+// lane, to a vector of elements. CountIfEach uses vector instructions when all
+// its predicates are Lanewise over the value type of the range.
+
+template <typename T>
+struct LessThan {
+    using Lanewise = T;
+    explicit LessThan(T c)
+          : c_(c) {}
+    template <typename U>
+    auto operator()(const U& x) const {
+        return x < c_;
+    }
+
+private:
+    T c_;
+};
+
+template <typename T>
+struct GreaterThan {
+    using Lanewise = T;
+    explicit GreaterThan(T c)
+          : c_(c) {}
+    template <typename U>
+    auto operator()(const U& x) const {
+        return x > c_;
+    }
+
+private:
+    T c_;
+};
+
+template <typename T>
+struct EqualTo {
+    using Lanewise = T;
+    explicit EqualTo(T c)
+          : c_(c) {}
+    template <typename U>
+    auto operator()(const U& x) const {
+        return x == c_;
+    }
+
+private:
+    T c_;
+};
+
+template <typename P, typename T, typename = void>
+struct IsLanewise : std::false_type {};
+
+template <typename P, typename T>
+struct IsLanewise<P, T, std::void_t<typename P::Lanewise>> : std::is_same<typename P::Lanewise, T> {};
+
+#if defined(__GNUC__)
+
+// 16 bytes of T: the width every x86-64 and AArch64 target has
+template <typename T>
+struct VectorOf {
+    typedef T type __attribute__((vector_size(16)));
+};
+
+template <typename I>
+constexpr bool IsContiguous = std::is_pointer_v<I> ||
+                              std::is_same_v<I, typename std::vector<typename std::iterator_traits<I>::value_type>::iterator> ||
+                              std::is_same_v<I, typename std::vector<typename std::iterator_traits<I>::value_type>::const_iterator>;
+
+template <typename I, typename Ps>
+struct CountsVectorized : std::false_type {};
+
+// contiguous ranges of integers or floating point numbers of up to 8 bytes
+template <typename I, typename... P>
+struct CountsVectorized<I, std::tuple<P...>> {
+    using T = std::remove_cv_t<typename std::iterator_traits<I>::value_type>;
+    static constexpr bool value = std::is_arithmetic_v<T> && not std::is_same_v<T, bool> && sizeof(T) <= 8 &&
+                                  IsContiguous<I> && (IsLanewise<P, T>::value && ...);
+};
+
+template <typename M>
+long long SumLanes(const M& m) {
+    long long s = 0;
+    for (std::size_t i = 0; i < sizeof(M) / sizeof(m[0]); ++i)
+        s += m[i];
+    return s;
+}
+
+template <typename T, typename Ps, typename J, std::size_t K, std::size_t... Is>
+void CountIfEachVectorized(const T* f, std::size_t n, const Ps& ps, std::array<J, K>& j, std::index_sequence<Is...>) {
+    using V = typename VectorOf<T>::type;
+    constexpr std::size_t lanes = sizeof(V) / sizeof(T);
+    // a comparison yields -1 in each lane that holds; subtracting the masks
+    // counts per lane in counters as narrow as the elements, so they are
+    // flushed before the narrowest ones (8 bit) can overflow
+    constexpr std::size_t flush = 127;
+    while (n >= lanes) {
+        const std::size_t blocks = std::min(n / lanes, flush);
+        std::tuple<decltype(std::get<Is>(ps)(V{}))...> acc{};
+        for (std::size_t b = 0; b < blocks; ++b) {
+            V x;
+            std::memcpy(&x, f, sizeof(V));
+            ((std::get<Is>(acc) -= std::get<Is>(ps)(x)), ...);
+            f += lanes;
+        }
+        n -= blocks * lanes;
+        ((j[Is] += static_cast<J>(SumLanes(std::get<Is>(acc)))), ...);
+    }
+    while (n != 0) {
+        CountIfEachStep(*f, ps, j, std::index_sequence<Is...>());
+        ++f;
+        --n;
+    }
+}
+
+#endif
+
+// Counts the elements satisfying each predicate of the tuple ps into the
+// corresponding position of j
+template <typename I, typename Ps, typename J, std::size_t K>
+std::array<J, K> CountIfEach(I f, I l, const Ps& ps, std::array<J, K> j) {
+    static_assert(std::tuple_size_v<Ps> == K, "one count per predicate");
+#if defined(__GNUC__)
+    if constexpr (CountsVectorized<I, Ps>::value) {
+        if (f != l)
+            CountIfEachVectorized(&*f, std::size_t(l - f), ps, j, std::make_index_sequence<K>());
+        return j;
+    }
+#endif
+    while (f != l) {
+        CountIfEachStep(*f, ps, j, std::make_index_sequence<K>());
+        ++f;
+    }
+    return j;
+}
+
+// Histogram: increments o[b(x)] for each element x
+template <typename I, typename B, typename O>
+O CountBuckets(I f, I l, B b, O o) {
+    // precondition: o[b(x)] is writable for each element x
+    while (f != l) {
+        ++o[b(*f)];
+        ++f;
+    }
+    return o;
+}
+
+// Splits [f, l) in up to threads chunks and calls proc(fi, li, i) for chunk i,
+// each one in its own thread
+template <typename I, typename Proc>
+void ForEachChunkParallel(I f, I l, unsigned threads, Proc proc) {
+    // precondition: 0 < threads
+    const auto n = l - f;
+    const auto chunk = (n + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; n != 0 && i < threads && i * chunk < n; ++i) {
+        const I fi = f + i * chunk;
+        const I li = (i + 1) * chunk < n ? f + (i + 1) * chunk : l;
+        workers.emplace_back([&proc, fi, li, i]() { proc(fi, li, i); });
+    }
+    for (auto& w : workers)
+        w.join();
+}
+
+// CountIfEach with each thread counting its chunk privately; the counts are
+// merged at the end
+template <typename I, typename Ps, typename J, std::size_t K>
+std::array<J, K> CountIfEachParallel(I f, I l, const Ps& ps, std::array<J, K> j, unsigned threads) {
+    std::vector<std::array<J, K>> counts(threads);
+    ForEachChunkParallel(f, l, threads, [&ps, &counts](I fi, I li, unsigned i) {
+        std::array<J, K> zero;
+        zero.fill(J{ 0 });
+        counts[i] = CountIfEach(fi, li, ps, zero);
+    });
+    for (const auto& c : counts)
+        for (std::size_t k = 0; k < K; ++k)
+            j[k] += c[k];
+    return j;
+}
+
+// CountBuckets over n buckets with each thread counting its chunk privately;
+// the counts are merged into o at the end
+template <typename I, typename B, typename O>
+O CountBucketsParallel(I f, I l, B b, std::size_t n, O o, unsigned threads) {
+    // precondition: b(x) < n for each element x
+    using J = typename std::iterator_traits<O>::value_type;
+    std::vector<std::vector<J>> counts(threads);
+    ForEachChunkParallel(f, l, threads, [&b, &counts, n](I fi, I li, unsigned i) {
+        std::vector<J> c(n, J{ 0 });
+        CountBuckets(fi, li, b, c.begin());
+        counts[i] = std::move(c);
+    });
+    for (const auto& c : counts)
+        for (std::size_t k = 0; k < c.size(); ++k)
+            o[k] += c[k];
+    return o;
+}
+
 template <typename I, typename Op, typename F>
 auto ReduceNonEmpty(I f, I l, Op op, F fun) -> std::result_of_t<F(I)> {
     // precondition f != l
     std::result_of_t<F(I)> r = fun(f);
     ++f;
     while (f != l) {
-        r = op(r, fun(f));
+        r = op(std::move(r), fun(f));
         ++f;
     }
     return r;
@@ -59,6 +369,57 @@ auto Reduce(I f, I l, Op op, F fun, const std::result_of_t<F(I)>& z) -> std::res
     return ReduceNonEmpty(f, l, op, fun);
 }
 
+// Reduction with K independent accumulators: there is no loop carried
+// dependency between consecutive elements, so the CPU can overlap (or the
+// compiler vectorize) K applications of op. The accumulators are combined
+// pairwise at the end.
+template <std::size_t K = 4, typename I, typename Op, typename F>
+auto ReduceInterleaved(I f, I l, Op op, F fun, const std::result_of_t<F(I)>& z) -> std::result_of_t<F(I)> {
+    // precondition: op is associative and commutative and z is its identity
+    static_assert(K > 0, "at least one accumulator is needed");
+    std::array<std::result_of_t<F(I)>, K> r;
+    r.fill(z);
+    using Category = typename std::iterator_traits<I>::iterator_category;
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag, Category>) {
+        auto n = l - f;
+        while (n >= static_cast<decltype(n)>(K)) {
+            for (std::size_t i = 0; i < K; ++i) {
+                r[i] = op(std::move(r[i]), fun(f));
+                ++f;
+            }
+            n -= K;
+        }
+    }
+    for (std::size_t i = 0; f != l; i = (i + 1) % K) {
+        r[i] = op(std::move(r[i]), fun(f));
+        ++f;
+    }
+    for (std::size_t step = 1; step < K; step *= 2)
+        for (std::size_t i = 0; i + step < K; i += 2 * step)
+            r[i] = op(std::move(r[i]), std::move(r[i + step]));
+    return r[0];
+}
+
+// Neumaier's compensated summation: the rounding error of each addition is
+// accumulated separately and added back at the end
+template <typename I, typename F>
+auto SumCompensated(I f, I l, F fun, const std::result_of_t<F(I)>& z) -> std::result_of_t<F(I)> {
+    using T = std::result_of_t<F(I)>;
+    T s = z;
+    T c = T{ 0 };
+    while (f != l) {
+        const T x = fun(f);
+        const T t = s + x;
+        if (std::abs(s) >= std::abs(x))
+            c += (s - t) + x;
+        else
+            c += (x - t) + s;
+        s = t;
+        ++f;
+    }
+    return s + c;
+}
+
 template <typename I0, typename I1, typename R>
 std::pair<I0, I1> FindMismatch(I0 f0, I0 l0, I1 f1, I1 l1, R r) {
     while (f0 != l0 && f1 != l1 && r(*f0, *f1)) {
@@ -80,4 +441,41 @@ I FindAdjacentMismatch(I f, I l, R r) {
     }
     return f;
 }
+
+// Section 6.6
+
+template <typename I, typename P>
+I PartitionPointN(I f, typename std::iterator_traits<I>::difference_type n, P p) {
+    // precondition: [f, f + n) is partitioned by p (false values first)
+    while (n != 0) {
+        const auto h = n / 2;
+        I m = f;
+        std::advance(m, h);
+        if (p(*m)) {
+            n = h;
+        } else {
+            n = n - (h + 1);
+            f = ++m;
+        }
+    }
+    return f;
+}
+
+template <typename I, typename P>
+I PartitionPoint(I f, I l, P p) {
+    // precondition: [f, l) is partitioned by p (false values first)
+    return PartitionPointN(f, std::distance(f, l), p);
+}
+
+template <typename I, typename R>
+I LowerBound(I f, I l, const typename std::iterator_traits<I>::value_type& a, R r) {
+    // precondition: [f, l) is increasing with respect to r
+    return PartitionPoint(f, l, [&a, &r](const auto& x) { return not r(x, a); });
+}
+
+template <typename I, typename R>
+I UpperBound(I f, I l, const typename std::iterator_traits<I>::value_type& a, R r) {
+    // precondition: [f, l) is increasing with respect to r
+    return PartitionPoint(f, l, [&a, &r](const auto& x) { return r(a, x); });
+}
 }
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "EofP/chapter_06/Iterators.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <vector>
+
+namespace EofP {
+
+// Allocates on cache line boundaries, so that blocks of a layout that fill a
+// line are not split over two of them
+template <typename T>
+struct CacheLineAllocator {
+    using value_type = T;
+    static constexpr std::size_t alignment = 64;
+
+    CacheLineAllocator() = default;
+    template <typename U>
+    CacheLineAllocator(const CacheLineAllocator<U>&) {}
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+    }
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(alignment));
+    }
+    template <typename U>
+    [[nodiscard]] friend bool operator==(const CacheLineAllocator&, const CacheLineAllocator<U>&) {
+        return true;
+    }
+    template <typename U>
+    [[nodiscard]] friend bool operator!=(const CacheLineAllocator&, const CacheLineAllocator<U>&) {
+        return false;
+    }
+};
+
+template <typename T>
+using CacheLineVector = std::vector<T, CacheLineAllocator<T>>;
+
+// Read only search structures built from an increasing range. The elements
+// are re-laid so that a search touches few cache lines and its descent has
+// no unpredictable branches. Searches return a pointer to the element found
+// or nullptr when every element precedes the key.
+
+// Eytzinger (breadth first) layout: the children of position k are 2k and
+// 2k + 1, so the nodes of the next levels are contiguous and can be
+// prefetched several levels ahead of the descent.
+template <typename T, typename R = std::less<T>>
+struct EytzingerLayout {
+    template <typename I>
+    EytzingerLayout(I f, I l, R r = R())
+          : a_(std::distance(f, l) + 1), r_(r) {
+        // precondition: [f, l) is increasing with respect to r
+        Fill(f, 1);
+    }
+    [[nodiscard]] std::size_t Size() const {
+        return a_.size() - 1;
+    }
+    const T* LowerBound(const T& x) const {
+        return Descend([this, &x](const T& a) { return r_(a, x); });
+    }
+    const T* UpperBound(const T& x) const {
+        return Descend([this, &x](const T& a) { return not r_(x, a); });
+    }
+
+private:
+    // the lookahead descendants of k, some levels down, are contiguous from
+    // lookahead * k; with lookahead elements filling a line and a_ aligned on
+    // a line, they are exactly one line
+    static constexpr std::size_t PowerOfTwoBelow(std::size_t n) {
+        std::size_t p = 1;
+        while (2 * p <= n)
+            p *= 2;
+        return p;
+    }
+    static constexpr std::size_t lookahead = PowerOfTwoBelow(64 / sizeof(T) < 2 ? 2 : 64 / sizeof(T));
+
+    template <typename I>
+    void Fill(I& f, std::size_t k) {
+        if (k < a_.size()) {
+            Fill(f, 2 * k);
+            a_[k] = *f;
+            ++f;
+            Fill(f, 2 * k + 1);
+        }
+    }
+
+    // p is true for the elements preceding the one searched
+    template <typename P>
+    const T* Descend(P p) const {
+        const std::size_t n = a_.size();
+        const auto base = reinterpret_cast<std::uintptr_t>(a_.data());
+        std::size_t k = 1;
+        while (k < n) {
+            PrefetchAddress(reinterpret_cast<const void*>(base + lookahead * k * sizeof(T)));
+            k = 2 * k + static_cast<std::size_t>(p(a_[k]));
+        }
+        // the answer is where the descent last went left: drop the trailing
+        // right turns and then that left turn
+        k >>= TrailingOnes(k) + 1;
+        return k == 0 ? nullptr : &a_[k];
+    }
+
+    static int TrailingOnes(std::size_t k) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(~static_cast<unsigned long long>(k));
+#else
+        int n = 0;
+        while (k & 1) {
+            k >>= 1;
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    CacheLineVector<T> a_;
+    R r_;
+};
+
+// Implicit B-tree layout: nodes of B keys stored contiguously, with the
+// children of node i being nodes i * (B + 1) + 1 ... i * (B + 1) + B + 1.
+// Each node is scanned without branches, which compilers vectorize, and
+// with B keys filling a cache line the search touches one line per level.
+template <typename T, std::size_t B = 64 / sizeof(T) ? 64 / sizeof(T) : 1, typename R = std::less<T>>
+struct BTreeLayout {
+    template <typename I>
+    BTreeLayout(I f, I l, R r = R())
+          : n_(std::distance(f, l)), nodes_((n_ + B - 1) / B), b_(nodes_ * B), r_(r) {
+        // precondition: [f, l) is increasing with respect to r
+        if (n_ == 0)
+            return;
+        // the slots after the last element in order are padded with copies of
+        // it, so nodes are full and the padding never precedes a real element
+        std::size_t filled = 0;
+        T last = *f;
+        Fill(f, 0, filled, last);
+    }
+    [[nodiscard]] std::size_t Size() const {
+        return n_;
+    }
+    const T* LowerBound(const T& x) const {
+        return Descend([this, &x](const T& a) { return r_(a, x); });
+    }
+    const T* UpperBound(const T& x) const {
+        return Descend([this, &x](const T& a) { return not r_(x, a); });
+    }
+
+private:
+    template <typename I>
+    void Fill(I& f, std::size_t i, std::size_t& filled, T& last) {
+        if (i >= nodes_)
+            return;
+        for (std::size_t j = 0; j <= B; ++j) {
+            Fill(f, i * (B + 1) + j + 1, filled, last);
+            if (j < B) {
+                if (filled < n_) {
+                    last = *f;
+                    ++f;
+                    ++filled;
+                }
+                b_[i * B + j] = last;
+            }
+        }
+    }
+
+    // p is true for the elements preceding the one searched
+    template <typename P>
+    const T* Descend(P p) const {
+        const T* r = nullptr;
+        std::size_t i = 0;
+        while (i < nodes_) {
+            const T* node = &b_[i * B];
+            std::size_t j = 0;
+            for (std::size_t t = 0; t < B; ++t)
+                j += static_cast<std::size_t>(p(node[t]));
+            if (j < B)
+                r = node + j;
+            i = i * (B + 1) + j + 1;
+        }
+        return r;
+    }
+
+    std::size_t n_;
+    std::size_t nodes_;
+    CacheLineVector<T> b_;
+    R r_;
+};
+}
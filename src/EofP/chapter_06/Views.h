@@ -0,0 +1,274 @@
+#pragma once
+
+#include "EofP/chapter_06/Iterators.h"
+
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace EofP {
+
+// Lazy views: iterator adapters that fuse filter/transform/take-while/zip
+// stages into the single loop of the terminal algorithm, without
+// intermediate buffers
+
+template <typename I>
+struct Range {
+    using Iterator = I;
+    Range(I f, I l)
+          : f_(std::move(f)), l_(std::move(l)) {}
+    I begin() const { return f_; }
+    I end() const { return l_; }
+
+private:
+    I f_;
+    I l_;
+};
+
+template <typename I>
+Range<I> MakeRange(I f, I l) {
+    return Range<I>(std::move(f), std::move(l));
+}
+
+template <typename C>
+auto MakeRange(C& c) -> Range<decltype(std::begin(c))> {
+    return MakeRange(std::begin(c), std::end(c));
+}
+
+// Closures are copyable but not assignable; adapted iterators must be both
+template <typename F>
+struct AssignableFunction {
+    explicit AssignableFunction(F f)
+          : f_(std::move(f)) {}
+    AssignableFunction(const AssignableFunction&) = default;
+    AssignableFunction& operator=(const AssignableFunction& x) {
+        if (this != &x) {
+            f_.reset();
+            f_.emplace(*x.f_);
+        }
+        return *this;
+    }
+    template <typename... A>
+    decltype(auto) operator()(A&&... a) const {
+        return (*f_)(std::forward<A>(a)...);
+    }
+
+private:
+    std::optional<F> f_;
+};
+
+// The result of fun is cached until the iterator moves: later stages may
+// dereference an element more than once (a filter tests it, then yields it)
+// and fun must still be applied once per element
+template <typename I, typename F>
+struct TransformIterator {
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::decay_t<std::result_of_t<const F&(typename std::iterator_traits<I>::reference)>>;
+    using reference = const value_type&;
+    using difference_type = typename std::iterator_traits<I>::difference_type;
+    using pointer = void;
+
+    TransformIterator(I i, F fun)
+          : i_(std::move(i)), fun_(std::move(fun)) {}
+    // the payload of a disengaged cache is not copied
+    TransformIterator(const TransformIterator& x)
+          : i_(x.i_), fun_(x.fun_) {
+        if (x.cache_)
+            cache_.emplace(*x.cache_);
+    }
+    TransformIterator& operator=(const TransformIterator& x) {
+        if (this != &x) {
+            i_ = x.i_;
+            fun_ = x.fun_;
+            cache_.reset();
+            if (x.cache_)
+                cache_.emplace(*x.cache_);
+        }
+        return *this;
+    }
+    reference operator*() const {
+        if (not cache_)
+            cache_.emplace(fun_(*i_));
+        return *cache_;
+    }
+    TransformIterator& operator++() {
+        ++i_;
+        cache_.reset();
+        return *this;
+    }
+    [[nodiscard]] friend bool operator==(const TransformIterator& x, const TransformIterator& y) {
+        return x.i_ == y.i_;
+    }
+    [[nodiscard]] friend bool operator!=(const TransformIterator& x, const TransformIterator& y) {
+        return x.i_ != y.i_;
+    }
+
+private:
+    I i_;
+    AssignableFunction<F> fun_;
+    mutable std::optional<value_type> cache_;
+};
+
+template <typename I, typename P>
+struct FilterIterator {
+    using iterator_category = std::input_iterator_tag;
+    using reference = typename std::iterator_traits<I>::reference;
+    using value_type = typename std::iterator_traits<I>::value_type;
+    using difference_type = typename std::iterator_traits<I>::difference_type;
+    using pointer = void;
+
+    FilterIterator(I i, I l, P p)
+          : i_(std::move(i)), l_(std::move(l)), p_(std::move(p)) {
+        i_ = FindIf(i_, l_, std::cref(p_));
+    }
+    reference operator*() const {
+        return *i_;
+    }
+    FilterIterator& operator++() {
+        ++i_;
+        i_ = FindIf(i_, l_, std::cref(p_));
+        return *this;
+    }
+    [[nodiscard]] friend bool operator==(const FilterIterator& x, const FilterIterator& y) {
+        return x.i_ == y.i_;
+    }
+    [[nodiscard]] friend bool operator!=(const FilterIterator& x, const FilterIterator& y) {
+        return x.i_ != y.i_;
+    }
+
+private:
+    I i_;
+    I l_;
+    AssignableFunction<P> p_;
+};
+
+template <typename I, typename P>
+struct TakeWhileIterator {
+    using iterator_category = std::input_iterator_tag;
+    using reference = typename std::iterator_traits<I>::reference;
+    using value_type = typename std::iterator_traits<I>::value_type;
+    using difference_type = typename std::iterator_traits<I>::difference_type;
+    using pointer = void;
+
+    // the predicate is applied once per element: as soon as it fails the
+    // iterator jumps to the limit, so the comparison with the end is plain
+    TakeWhileIterator(I i, I l, P p)
+          : i_(std::move(i)), l_(std::move(l)), p_(std::move(p)) {
+        Settle();
+    }
+    reference operator*() const {
+        return *i_;
+    }
+    TakeWhileIterator& operator++() {
+        ++i_;
+        Settle();
+        return *this;
+    }
+    [[nodiscard]] friend bool operator==(const TakeWhileIterator& x, const TakeWhileIterator& y) {
+        return x.i_ == y.i_;
+    }
+    [[nodiscard]] friend bool operator!=(const TakeWhileIterator& x, const TakeWhileIterator& y) {
+        return x.i_ != y.i_;
+    }
+
+private:
+    void Settle() {
+        if (i_ != l_ && not p_(*i_))
+            i_ = l_;
+    }
+
+    I i_;
+    I l_;
+    AssignableFunction<P> p_;
+};
+
+template <typename I0, typename I1>
+struct ZipIterator {
+    using iterator_category = std::input_iterator_tag;
+    using reference = std::pair<typename std::iterator_traits<I0>::reference,
+          typename std::iterator_traits<I1>::reference>;
+    using value_type = std::pair<typename std::iterator_traits<I0>::value_type,
+          typename std::iterator_traits<I1>::value_type>;
+    using difference_type = std::common_type_t<typename std::iterator_traits<I0>::difference_type,
+          typename std::iterator_traits<I1>::difference_type>;
+    using pointer = void;
+
+    ZipIterator(I0 i0, I1 i1)
+          : i0_(std::move(i0)), i1_(std::move(i1)) {}
+    reference operator*() const {
+        return reference(*i0_, *i1_);
+    }
+    ZipIterator& operator++() {
+        ++i0_;
+        ++i1_;
+        return *this;
+    }
+    std::pair<I0, I1> Base() const {
+        return std::make_pair(i0_, i1_);
+    }
+    // as in FindMismatch, the walk stops when either range is exhausted
+    [[nodiscard]] friend bool operator==(const ZipIterator& x, const ZipIterator& y) {
+        return x.i0_ == y.i0_ || x.i1_ == y.i1_;
+    }
+    [[nodiscard]] friend bool operator!=(const ZipIterator& x, const ZipIterator& y) {
+        return not(x == y);
+    }
+
+private:
+    I0 i0_;
+    I1 i1_;
+};
+
+template <typename I, typename F>
+Range<TransformIterator<I, F>> Transform(const Range<I>& r, F fun) {
+    return MakeRange(TransformIterator<I, F>(r.begin(), fun), TransformIterator<I, F>(r.end(), fun));
+}
+
+template <typename I, typename P>
+Range<FilterIterator<I, P>> Filter(const Range<I>& r, P p) {
+    return MakeRange(FilterIterator<I, P>(r.begin(), r.end(), p), FilterIterator<I, P>(r.end(), r.end(), p));
+}
+
+template <typename I, typename P>
+Range<TakeWhileIterator<I, P>> TakeWhile(const Range<I>& r, P p) {
+    return MakeRange(TakeWhileIterator<I, P>(r.begin(), r.end(), p), TakeWhileIterator<I, P>(r.end(), r.end(), p));
+}
+
+template <typename I0, typename I1>
+Range<ZipIterator<I0, I1>> Zip(const Range<I0>& r0, const Range<I1>& r1) {
+    return MakeRange(ZipIterator<I0, I1>(r0.begin(), r1.begin()), ZipIterator<I0, I1>(r0.end(), r1.end()));
+}
+
+// Terminal operations: each one is a single loop of the underlying algorithm
+
+template <typename I>
+struct Source {
+    typename std::iterator_traits<I>::value_type operator()(const I& i) const {
+        return *i;
+    }
+};
+
+template <typename I, typename P>
+P ForEach(const Range<I>& r, P p) {
+    return ForEach(r.begin(), r.end(), std::move(p));
+}
+
+template <typename I, typename P, typename J>
+J CountIf(const Range<I>& r, P p, J j) {
+    return CountIf(r.begin(), r.end(), p, j);
+}
+
+template <typename I, typename Op>
+auto ReduceNonEmpty(const Range<I>& r, Op op) -> typename std::iterator_traits<I>::value_type {
+    // precondition r is not empty
+    return ReduceNonEmpty(r.begin(), r.end(), op, Source<I>());
+}
+
+template <typename I, typename Op>
+auto Reduce(const Range<I>& r, Op op, const typename std::iterator_traits<I>::value_type& z)
+      -> typename std::iterator_traits<I>::value_type {
+    return Reduce(r.begin(), r.end(), op, Source<I>(), z);
+}
+}
@@ -1,9 +1,15 @@
 #pragma once
 
+#include "EofP/chapter_06/Iterators.h"
+
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <deque>
 #include <iterator>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace EofP {
 
@@ -60,6 +66,9 @@ struct BifurcateCoordinate {
     BifurcateCoordinate RightSuccessor() const {
         return BifurcateCoordinate(*(node_->right));
     }
+    void Prefetch() const {
+        PrefetchAddress(node_);
+    }
 
 private:
     Node* node_;
@@ -95,6 +104,14 @@ int HeightRecursive(C c) {
     return std::max(l, r) + 1;
 }
 
+// The successor taken at a step of a descent, and the steps from a root
+enum class Direction {
+    LEFT,
+    RIGHT
+};
+
+using Path = std::vector<Direction>;
+
 enum class Visit {
     PRE,
     IN,
@@ -105,15 +122,99 @@ template <typename C, typename Proc>
 Proc TraverseNonempty(C c, Proc proc) {
     proc(Visit::PRE, c);
     if (c.HasLeftSuccessor())
-        proc = TraverseNonempty(c.LeftSuccessor(), proc);
+        proc = TraverseNonempty(c.LeftSuccessor(), std::move(proc));
     proc(Visit::IN, c);
     if (c.HasRightSuccessor())
-        proc = TraverseNonempty(c.RightSuccessor(), proc);
+        proc = TraverseNonempty(c.RightSuccessor(), std::move(proc));
     proc(Visit::POST, c);
 
     return proc;
 }
 
+// Same visits as TraverseNonempty, with the successors prefetched before the
+// current node is visited. The load of the right successor overlaps the whole
+// left subtree, but the left successor is visited next and its address is
+// only known once c is loaded: its load overlaps just the PRE visit of c, and
+// a descent to the left still pays one miss per level. TraversePrefetch
+// overlaps every load.
+template <typename C, typename Proc>
+Proc TraverseNonemptyPrefetch(C c, Proc proc) {
+    if (c.HasLeftSuccessor())
+        c.LeftSuccessor().Prefetch();
+    if (c.HasRightSuccessor())
+        c.RightSuccessor().Prefetch();
+    proc(Visit::PRE, c);
+    if (c.HasLeftSuccessor())
+        proc = TraverseNonemptyPrefetch(c.LeftSuccessor(), std::move(proc));
+    proc(Visit::IN, c);
+    if (c.HasRightSuccessor())
+        proc = TraverseNonemptyPrefetch(c.RightSuccessor(), std::move(proc));
+    proc(Visit::POST, c);
+
+    return proc;
+}
+
+// Visits every node once, in no specified order, calling proc(c, depth) with
+// the root at depth 1. Up to Lanes depth first walks advance in round robin,
+// each on its own stack; a coordinate is prefetched when it is pushed, and by
+// the time its walk pops it the other walks have made a visit each, so that
+// Lanes loads are in flight at once. A walk that runs out of nodes takes the
+// shallowest pending node of another walk, so the memory used is bounded by
+// Lanes stacks as deep as the tree.
+template <std::size_t Lanes = 8, typename C, typename Proc>
+Proc TraversePrefetch(C c, Proc proc) {
+    static_assert(0 < Lanes, "at least one walk");
+    if (c.Empty())
+        return proc;
+
+    std::array<std::deque<std::pair<C, int>>, Lanes> stacks;
+    stacks[0].emplace_back(c, 1);
+    std::size_t pending = 1;
+    for (std::size_t i = 0; pending != 0; i = (i + 1) % Lanes) {
+        auto& stack = stacks[i];
+        if (stack.empty()) {
+            for (auto& other : stacks) {
+                if (other.size() >= 2) {
+                    other.front().first.Prefetch();
+                    stack.push_back(other.front());
+                    other.pop_front();
+                    break;
+                }
+            }
+            continue;
+        }
+        const auto [x, depth] = stack.back();
+        stack.pop_back();
+        --pending;
+        proc(x, depth);
+        if (x.HasRightSuccessor()) {
+            stack.emplace_back(x.RightSuccessor(), depth + 1);
+            stack.back().first.Prefetch();
+            ++pending;
+        }
+        if (x.HasLeftSuccessor()) {
+            stack.emplace_back(x.LeftSuccessor(), depth + 1);
+            stack.back().first.Prefetch();
+            ++pending;
+        }
+    }
+    return proc;
+}
+
+template <typename C>
+int WeightPrefetch(C c) {
+    int n = 0;
+    TraversePrefetch(c, [&n](const C&, int) { ++n; });
+    return n;
+}
+
+template <typename C>
+int HeightPrefetch(C c) {
+    int h = 0;
+    TraversePrefetch(c, [&h](const C&, int depth) { h = std::max(h, depth); });
+    return h;
+}
+
 // Section 7.2
 
 template <typename T>
@@ -173,6 +274,9 @@ struct BidirectionalBifurcateCoordinate {
     BidirectionalBifurcateCoordinate RightSuccessor() const {
         return BidirectionalBifurcateCoordinate(*(node_->right));
     }
+    void Prefetch() const {
+        PrefetchAddress(node_);
+    }
     BidirectionalBifurcateCoordinate Predecessor() const {
         return BidirectionalBifurcateCoordinate(*node_->predecessor);
     }
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "EofP/chapter_07/CoordinateStructures.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_set>
+#include <utility>
+
+namespace EofP {
+
+// Trees built by hash consing: immutable nodes are interned, so structurally
+// identical subtrees are stored once and the tree is really a DAG. Weight and
+// height are computed once per distinct node, when it is created. With
+// sharing a tree of height h may have 2^h - 1 nodes, so the weight is 64 bit
+// (it wraps only beyond height 64).
+
+template <typename T>
+struct HashConsedCoordinate;
+
+template <typename T, typename H>
+struct HashConsedTreeBuilder;
+
+template <typename T>
+struct HashConsedNode {
+    using Type = T;
+    HashConsedNode(T t, const HashConsedNode* l, const HashConsedNode* r)
+          : value(std::move(t)),
+            left(l),
+            right(r),
+            weight((l ? l->weight : 0) + (r ? r->weight : 0) + 1),
+            height(std::max(l ? l->height : 0, r ? r->height : 0) + 1) {}
+
+private:
+    const T value;
+    const HashConsedNode* const left;
+    const HashConsedNode* const right;
+    const std::uint64_t weight;
+    const int height;
+
+    friend struct HashConsedCoordinate<T>;
+    template <typename, typename>
+    friend struct HashConsedTreeBuilder;
+};
+
+template <typename T>
+struct HashConsedCoordinate {
+    using Node = HashConsedNode<T>;
+    using Type = T;
+    HashConsedCoordinate()
+          : node_(nullptr) {}
+    explicit HashConsedCoordinate(const Node& node)
+          : node_(&node) {}
+    const T& operator*() const {
+        return node_->value;
+    }
+    [[nodiscard]] bool Empty() const {
+        return node_ == nullptr;
+    }
+    [[nodiscard]] bool HasLeftSuccessor() const {
+        return node_->left != nullptr;
+    }
+    [[nodiscard]] bool HasRightSuccessor() const {
+        return node_->right != nullptr;
+    }
+    HashConsedCoordinate LeftSuccessor() const {
+        return HashConsedCoordinate(*node_->left);
+    }
+    HashConsedCoordinate RightSuccessor() const {
+        return HashConsedCoordinate(*node_->right);
+    }
+    void Prefetch() const {
+        PrefetchAddress(node_);
+    }
+    [[nodiscard]] std::uint64_t Weight() const {
+        return Empty() ? 0 : node_->weight;
+    }
+    [[nodiscard]] int Height() const {
+        return Empty() ? 0 : node_->height;
+    }
+    // interned nodes are equal if and only if the subtrees are equal
+    [[nodiscard]] friend bool operator==(const HashConsedCoordinate& x, const HashConsedCoordinate& y) {
+        return x.node_ == y.node_;
+    }
+    [[nodiscard]] friend bool operator!=(const HashConsedCoordinate& x, const HashConsedCoordinate& y) {
+        return x.node_ != y.node_;
+    }
+
+private:
+    const Node* node_;
+
+    template <typename, typename>
+    friend struct HashConsedTreeBuilder;
+};
+
+template <typename T>
+std::uint64_t WeightRecursive(HashConsedCoordinate<T> c) {
+    return c.Weight();
+}
+
+template <typename T>
+int HeightRecursive(HashConsedCoordinate<T> c) {
+    return c.Height();
+}
+
+// Owns the nodes: coordinates are valid while the builder is alive
+template <typename T, typename H = std::hash<T>>
+struct HashConsedTreeBuilder {
+    using Node = HashConsedNode<T>;
+    using Coordinate = HashConsedCoordinate<T>;
+
+    HashConsedTreeBuilder() = default;
+    HashConsedTreeBuilder(const HashConsedTreeBuilder&) = delete;
+    HashConsedTreeBuilder& operator=(const HashConsedTreeBuilder&) = delete;
+
+    Coordinate Make(T t, Coordinate l = Coordinate(), Coordinate r = Coordinate()) {
+        nodes_.emplace_back(std::move(t), l.node_, r.node_);
+        const auto inserted = table_.insert(&nodes_.back());
+        if (not inserted.second)
+            nodes_.pop_back();
+        return Coordinate(**inserted.first);
+    }
+
+    // copies the tree of any bifurcate coordinate, sharing repeated subtrees
+    template <typename C>
+    Coordinate Intern(C c) {
+        if (c.Empty())
+            return Coordinate();
+
+        Coordinate l;
+        Coordinate r;
+        if (c.HasLeftSuccessor())
+            l = Intern(c.LeftSuccessor());
+        if (c.HasRightSuccessor())
+            r = Intern(c.RightSuccessor());
+
+        return Make(*c, l, r);
+    }
+
+    [[nodiscard]] std::size_t DistinctNodes() const {
+        return nodes_.size();
+    }
+
+private:
+    struct NodeHash {
+        std::size_t operator()(const Node* n) const {
+            const std::hash<const Node*> hp;
+            std::size_t h = H()(n->value);
+            h ^= hp(n->left) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+            h ^= hp(n->right) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+    struct NodeEqual {
+        bool operator()(const Node* x, const Node* y) const {
+            return x->left == y->left && x->right == y->right && x->value == y->value;
+        }
+    };
+
+    std::deque<Node> nodes_;
+    std::unordered_set<const Node*, NodeHash, NodeEqual> table_;
+};
+}
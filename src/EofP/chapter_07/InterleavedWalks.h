@@ -0,0 +1,134 @@
+#pragma once
+
+#include "EofP/chapter_07/CoordinateStructures.h"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+namespace EofP {
+
+// Batches of independent walks over a tree, each one a small state machine
+// advanced one node at a time in round robin. After a walk moves it
+// prefetches its next node and yields to the other walks, so up to Width
+// cache misses are in flight instead of one per pointer chased.
+
+// For each query in [f, l) descends from root following step(*q, c), which
+// returns the Direction to take or nullopt to stop, and calls out(q, c) with
+// the node where the descent stopped, either because step returned nullopt or
+// because the chosen successor does not exist. Results are
+// produced in completion order, not in query order.
+template <std::size_t Width = 8, typename C, typename I, typename Step, typename Out>
+Out DescendInterleaved(C root, I f, I l, Step step, Out out) {
+    // precondition: not root.Empty()
+    static_assert(Width > 0, "at least one walk is needed");
+    std::array<I, Width> query;
+    std::array<C, Width> node;
+    std::array<bool, Width> active;
+    std::size_t live = 0;
+    for (std::size_t w = 0; w < Width; ++w) {
+        active[w] = f != l;
+        if (active[w]) {
+            query[w] = f;
+            node[w] = root;
+            ++f;
+            ++live;
+        }
+    }
+
+    while (live != 0) {
+        for (std::size_t w = 0; w < Width; ++w) {
+            if (not active[w])
+                continue;
+            C& c = node[w];
+            const std::optional<Direction> d = step(*query[w], c);
+            if (d == Direction::LEFT && c.HasLeftSuccessor()) {
+                c = c.LeftSuccessor();
+                c.Prefetch();
+            } else if (d == Direction::RIGHT && c.HasRightSuccessor()) {
+                c = c.RightSuccessor();
+                c.Prefetch();
+            } else {
+                out(query[w], c);
+                if (f != l) {
+                    query[w] = f;
+                    c = root;
+                    ++f;
+                } else {
+                    active[w] = false;
+                    --live;
+                }
+            }
+        }
+    }
+    return out;
+}
+
+// For each pair (x, y) in [f, l) computes Reachable(x, y) and calls
+// out(q, result), with the walks interleaved as in DescendInterleaved
+template <std::size_t Width = 8, typename I, typename Out>
+Out ReachableInterleaved(I f, I l, Out out) {
+    static_assert(Width > 0, "at least one walk is needed");
+    using C = typename std::iterator_traits<I>::value_type::first_type;
+    struct Walk {
+        I q;
+        C root;
+        C x;
+        C y;
+        Visit v;
+        bool active;
+    };
+
+    std::array<Walk, Width> walk;
+    std::size_t live = 0;
+    // starts the next query in w, answering right away those with an empty
+    // origin; returns whether a walk was started
+    auto start = [&f, &l, &out](Walk& w) {
+        while (f != l) {
+            const I q = f;
+            ++f;
+            if ((*q).first.Empty()) {
+                out(q, false);
+                continue;
+            }
+            w.q = q;
+            w.root = (*q).first;
+            w.x = w.root;
+            w.y = (*q).second;
+            w.v = Visit::PRE;
+            return true;
+        }
+        return false;
+    };
+    for (auto& w : walk) {
+        w.active = start(w);
+        if (w.active)
+            ++live;
+    }
+
+    while (live != 0) {
+        for (auto& w : walk) {
+            if (not w.active)
+                continue;
+            bool done = false;
+            bool result = false;
+            if (w.x == w.y) {
+                done = true;
+                result = true;
+            } else {
+                TraverseStep(w.v, w.x);
+                w.x.Prefetch();
+                done = w.x == w.root && w.v == Visit::POST;
+            }
+            if (done) {
+                out(w.q, result);
+                w.active = start(w);
+                if (not w.active)
+                    --live;
+            }
+        }
+    }
+    return out;
+}
+}
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "EofP/chapter_07/CoordinateStructures.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace EofP {
+
+// Persistent binary trees: nodes are immutable and an update copies the path
+// from the root to the changed node, sharing everything else with the
+// previous version. The root of the current version is published atomically,
+// so readers take snapshots without locks while a writer prepares the next
+// version. Replaced nodes are reclaimed by epochs: a node retired at epoch e
+// is deleted once no reader pinned at an epoch not after e remains.
+
+template <typename T>
+struct PersistentCoordinate;
+
+template <typename T, std::size_t Readers>
+struct PersistentTree;
+
+template <typename T>
+struct PersistentNode {
+    using Type = T;
+    PersistentNode(T t, const PersistentNode* l, const PersistentNode* r)
+          : value(std::move(t)), left(l), right(r) {}
+
+private:
+    const T value;
+    const PersistentNode* const left;
+    const PersistentNode* const right;
+
+    friend struct PersistentCoordinate<T>;
+    template <typename, std::size_t>
+    friend struct PersistentTree;
+};
+
+template <typename T>
+struct PersistentCoordinate {
+    using Node = PersistentNode<T>;
+    using Type = T;
+    PersistentCoordinate()
+          : node_(nullptr) {}
+    explicit PersistentCoordinate(const Node& node)
+          : node_(&node) {}
+    const T& operator*() const {
+        return node_->value;
+    }
+    [[nodiscard]] bool Empty() const {
+        return node_ == nullptr;
+    }
+    [[nodiscard]] bool HasLeftSuccessor() const {
+        return node_->left != nullptr;
+    }
+    [[nodiscard]] bool HasRightSuccessor() const {
+        return node_->right != nullptr;
+    }
+    PersistentCoordinate LeftSuccessor() const {
+        return PersistentCoordinate(*node_->left);
+    }
+    PersistentCoordinate RightSuccessor() const {
+        return PersistentCoordinate(*node_->right);
+    }
+    void Prefetch() const {
+        PrefetchAddress(node_);
+    }
+    [[nodiscard]] friend bool operator==(const PersistentCoordinate& x, const PersistentCoordinate& y) {
+        return x.node_ == y.node_;
+    }
+    [[nodiscard]] friend bool operator!=(const PersistentCoordinate& x, const PersistentCoordinate& y) {
+        return x.node_ != y.node_;
+    }
+
+private:
+    const Node* node_;
+};
+
+// Readers is the maximum number of snapshots alive at the same time; Read
+// waits for a free slot when all are taken
+template <typename T, std::size_t Readers = 64>
+struct PersistentTree {
+    using Node = PersistentNode<T>;
+    using Coordinate = PersistentCoordinate<T>;
+
+    // Keeps the version it was taken from alive until destroyed
+    struct Snapshot {
+        Snapshot(Snapshot&& x) noexcept
+              : tree_(x.tree_), slot_(x.slot_), root_(x.root_) {
+            x.tree_ = nullptr;
+        }
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+        ~Snapshot() {
+            if (tree_ != nullptr)
+                tree_->slots_[slot_].epoch.store(0);
+        }
+        Coordinate Root() const {
+            return root_ == nullptr ? Coordinate() : Coordinate(*root_);
+        }
+
+    private:
+        Snapshot(const PersistentTree* tree, std::size_t slot, const Node* root)
+              : tree_(tree), slot_(slot), root_(root) {}
+
+        const PersistentTree* tree_;
+        std::size_t slot_;
+        const Node* root_;
+
+        friend struct PersistentTree;
+    };
+
+    PersistentTree()
+          : root_(nullptr), epoch_(1) {
+        for (auto& slot : slots_)
+            slot.epoch.store(0);
+    }
+    PersistentTree(const PersistentTree&) = delete;
+    PersistentTree& operator=(const PersistentTree&) = delete;
+    ~PersistentTree() {
+        // precondition: no snapshot is alive
+        DeleteTree(root_.load());
+        for (const auto& r : retired_)
+            delete r.second;
+    }
+
+    Snapshot Read() const {
+        for (;;) {
+            for (std::size_t i = 0; i < Readers; ++i) {
+                std::uint64_t free = 0;
+                if (slots_[i].epoch.compare_exchange_strong(free, epoch_.load()))
+                    return Snapshot(this, i, root_.load());
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // The writing operations are serialized among themselves. A path is the
+    // sequence of turns from the root to an existing node.
+
+    void SetRoot(T t) {
+        std::lock_guard<std::mutex> lock(writer_);
+        std::vector<const Node*> retired;
+        RetireTree(root_.load(), retired);
+        Publish(new Node(std::move(t), nullptr, nullptr), retired);
+    }
+    void SetValue(const Path& path, T t) {
+        Update(path, [&t](const Node* n, std::vector<const Node*>& retired) {
+            retired.push_back(n);
+            return new Node(std::move(t), n->left, n->right);
+        });
+    }
+    void AddLeftSuccessor(const Path& path, T t) {
+        Update(path, [&t](const Node* n, std::vector<const Node*>& retired) {
+            retired.push_back(n);
+            RetireTree(n->left, retired);
+            return new Node(n->value, new Node(std::move(t), nullptr, nullptr), n->right);
+        });
+    }
+    void AddRightSuccessor(const Path& path, T t) {
+        Update(path, [&t](const Node* n, std::vector<const Node*>& retired) {
+            retired.push_back(n);
+            RetireTree(n->right, retired);
+            return new Node(n->value, n->left, new Node(std::move(t), nullptr, nullptr));
+        });
+    }
+
+    // deletes the retired nodes no snapshot can reach any more
+    void Reclaim() {
+        std::lock_guard<std::mutex> lock(writer_);
+        ReclaimLocked();
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> epoch;
+    };
+
+    template <typename Rebuild>
+    void Update(const Path& path, Rebuild rebuild) {
+        std::lock_guard<std::mutex> lock(writer_);
+        std::vector<const Node*> retired;
+        Publish(CopyPath(root_.load(), path, 0, rebuild, retired), retired);
+    }
+
+    template <typename Rebuild>
+    static const Node* CopyPath(const Node* n, const Path& path, std::size_t i, Rebuild& rebuild, std::vector<const Node*>& retired) {
+        if (i == path.size())
+            return rebuild(n, retired);
+        retired.push_back(n);
+        if (path[i] == Direction::LEFT)
+            return new Node(n->value, CopyPath(n->left, path, i + 1, rebuild, retired), n->right);
+        return new Node(n->value, n->left, CopyPath(n->right, path, i + 1, rebuild, retired));
+    }
+
+    static void RetireTree(const Node* n, std::vector<const Node*>& retired) {
+        if (n == nullptr)
+            return;
+        retired.push_back(n);
+        RetireTree(n->left, retired);
+        RetireTree(n->right, retired);
+    }
+
+    static void DeleteTree(const Node* n) {
+        if (n == nullptr)
+            return;
+        DeleteTree(n->left);
+        DeleteTree(n->right);
+        delete n;
+    }
+
+    void Publish(const Node* root, const std::vector<const Node*>& retired) {
+        root_.store(root);
+        // a reader that may have seen the replaced nodes pinned an epoch not
+        // after the current one
+        const std::uint64_t e = epoch_.fetch_add(1);
+        for (const Node* n : retired)
+            retired_.emplace_back(e, n);
+        ReclaimLocked();
+    }
+
+    void ReclaimLocked() {
+        std::uint64_t oldest = UINT64_MAX;
+        for (const auto& slot : slots_) {
+            const std::uint64_t e = slot.epoch.load();
+            if (e != 0 && e < oldest)
+                oldest = e;
+        }
+        std::size_t kept = 0;
+        for (const auto& r : retired_) {
+            if (r.first < oldest)
+                delete r.second;
+            else
+                retired_[kept++] = r;
+        }
+        retired_.resize(kept);
+    }
+
+    std::atomic<const Node*> root_;
+    std::atomic<std::uint64_t> epoch_;
+    mutable std::array<Slot, Readers> slots_;
+    std::mutex writer_;
+    std::vector<std::pair<std::uint64_t, const Node*>> retired_;
+};
+}
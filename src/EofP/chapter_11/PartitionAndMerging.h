@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace EofP {
+
+// Section 11.2
+
+template <typename I, typename Op>
+auto AddToCounter(I f, I l, Op op, typename std::iterator_traits<I>::value_type x,
+      const typename std::iterator_traits<I>::value_type& z) -> typename std::iterator_traits<I>::value_type {
+    if (x == z)
+        return z;
+    while (f != l) {
+        if (*f == z) {
+            *f = std::move(x);
+            return z;
+        }
+        x = op(*f, std::move(x));
+        *f = z;
+        ++f;
+    }
+    return x;
+}
+
+template <typename I, typename Op>
+auto ReduceCounter(I f, I l, Op op, const typename std::iterator_traits<I>::value_type& z)
+      -> typename std::iterator_traits<I>::value_type {
+    while (f != l && *f == z)
+        ++f;
+    if (f == l)
+        return z;
+
+    typename std::iterator_traits<I>::value_type x = *f;
+    ++f;
+    while (f != l) {
+        if (*f != z)
+            x = op(*f, std::move(x));
+        ++f;
+    }
+    return x;
+}
+
+template <typename Op, typename T>
+struct CounterMachine {
+    CounterMachine(Op op, T z)
+          : op(op), z(std::move(z)), n(0) {
+        f.fill(this->z);
+    }
+    void operator()(T x) {
+        // precondition: must not be called 2^64 or more times
+        x = AddToCounter(f.begin(), f.begin() + n, op, std::move(x), z);
+        if (x != z) {
+            f[n] = std::move(x);
+            ++n;
+        }
+    }
+
+    Op op;
+    T z;
+    std::array<T, 64> f;
+    std::size_t n;
+};
+
+template <typename I, typename Op, typename F>
+auto ReduceBalanced(I f, I l, Op op, F fun, const std::result_of_t<F(I)>& z) -> std::result_of_t<F(I)> {
+    // precondition: op is associative and z is its identity
+    // higher counter positions hold earlier elements, so they are the left operands
+    CounterMachine<Op, std::result_of_t<F(I)>> c(op, z);
+    while (f != l) {
+        c(fun(f));
+        ++f;
+    }
+    return ReduceCounter(c.f.begin(), c.f.begin() + c.n, op, z);
+}
+}
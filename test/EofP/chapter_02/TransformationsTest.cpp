@@ -2,7 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <random>
 
 namespace EofP {
@@ -46,4 +48,102 @@ TEST(TransformationTest, lemma_2_1) {
         EXPECT_DOUBLE_EQ(e_xyz, EuclideanNorm(e_yz, x)) << msg;
     }
 }
+
+TEST(TransformationTest, packed_array) {
+    for (unsigned width : { 1U, 3U, 7U, 13U, 32U, 63U, 64U }) {
+        PackedArray a(200, width);
+        EXPECT_EQ(a.Size(), 200);
+        EXPECT_EQ(a.Width(), width);
+        const std::uint64_t mask = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+        for (std::uint64_t i = 0; i < 200; ++i)
+            a.Set(i, (i * 0x9e3779b97f4a7c15ULL) & mask);
+        a.Set(100, mask);
+        a.Set(101, 0);
+        for (std::uint64_t i = 0; i < 200; ++i) {
+            const std::uint64_t expected = i == 100 ? mask : i == 101 ? 0 : (i * 0x9e3779b97f4a7c15ULL) & mask;
+            EXPECT_EQ(a.Get(i), expected) << width << " " << i;
+        }
+    }
+}
+
+namespace {
+// handle size and cycle size by following the orbit point by point
+template <typename T, typename F>
+std::pair<std::uint64_t, std::uint64_t> orbit_structure(T x, F f) {
+    std::map<T, std::uint64_t> seen;
+    std::uint64_t i = 0;
+    while (seen.find(x) == seen.end()) {
+        seen[x] = i++;
+        x = f(x);
+    }
+    return std::make_pair(seen[x], i - seen[x]);
+}
+
+template <typename T, typename F>
+void check_orbit_table(const OrbitTable<T>& table, F f) {
+    std::map<T, std::uint64_t> cycle_ids;
+    for (std::uint64_t i = 0; i < table.Size(); ++i) {
+        const T x = static_cast<T>(i);
+        const auto expected = orbit_structure(x, f);
+        ASSERT_EQ(table.Successor(x), f(x));
+        EXPECT_EQ(table.HandleSize(x), expected.first) << i;
+        EXPECT_EQ(table.CycleSize(x), expected.second) << i;
+
+        // the id is the one of the cycle, identified by its least point
+        const T c = table.ConnectionPoint(x);
+        EXPECT_EQ(table.HandleSize(c), 0);
+        EXPECT_EQ(table.CycleId(c), table.CycleId(x));
+        T least = c;
+        for (T y = f(c); y != c; y = f(y))
+            least = std::min(least, y);
+        const auto it = cycle_ids.emplace(least, table.CycleId(x)).first;
+        EXPECT_EQ(it->second, table.CycleId(x)) << i;
+    }
+    EXPECT_EQ(cycle_ids.size(), table.CycleCount());
+}
+}
+
+TEST(TransformationTest, orbit_table_uint8) {
+    auto f = [](std::uint8_t x) { return static_cast<std::uint8_t>(x * x + 1); };
+    const OrbitTable<std::uint8_t> table(f);
+    EXPECT_EQ(table.Size(), 256);
+    check_orbit_table(table, f);
+}
+
+TEST(TransformationTest, orbit_table_uint8_permutation) {
+    auto f = [](std::uint8_t x) { return static_cast<std::uint8_t>(x * 37 + 11); };
+    const OrbitTable<std::uint8_t> table(f, 256, 3);
+    check_orbit_table(table, f);
+    for (unsigned x = 0; x < 256; ++x)
+        EXPECT_EQ(table.HandleSize(static_cast<std::uint8_t>(x)), 0);
+}
+
+TEST(TransformationTest, orbit_table_partial_domain) {
+    auto f = [](std::uint16_t x) { return static_cast<std::uint16_t>((x * x + 7) % 1000); };
+    const OrbitTable<std::uint16_t> table(f, 1000, 4);
+    EXPECT_EQ(table.Size(), 1000);
+    check_orbit_table(table, f);
+}
+
+TEST(TransformationTest, orbit_table_uint16_threads_agree) {
+    auto f = [](std::uint16_t x) {
+        std::uint32_t h = x;
+        h ^= h >> 7;
+        h *= 0x2c1b3c6dU;
+        h ^= h >> 12;
+        return static_cast<std::uint16_t>(h);
+    };
+    const OrbitTable<std::uint16_t> one(f, 65536, 1);
+    const OrbitTable<std::uint16_t> many(f);
+    EXPECT_EQ(one.CycleCount(), many.CycleCount());
+    for (std::uint32_t x = 0; x < 65536; ++x) {
+        const auto y = static_cast<std::uint16_t>(x);
+        ASSERT_EQ(one.Successor(y), many.Successor(y));
+        ASSERT_EQ(one.HandleSize(y), many.HandleSize(y));
+        ASSERT_EQ(one.CycleId(y), many.CycleId(y));
+        ASSERT_EQ(one.CycleSize(y), many.CycleSize(y));
+    }
+    for (std::uint32_t x = 0; x < 65536; x += 97)
+        EXPECT_EQ(one.HandleSize(static_cast<std::uint16_t>(x)), orbit_structure(static_cast<std::uint16_t>(x), f).first);
+}
 }
@@ -2,6 +2,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <numeric>
+#include <random>
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace EofP {
@@ -181,4 +189,232 @@ TEST(IteratorsTest, find_adjacent_mismatch_increase_not_found) {
     const auto expected = end(v);
     EXPECT_EQ(FindAdjacentMismatch(begin(v), end(v), relation), expected);
 }
+
+namespace {
+template <typename I>
+auto Value(I i) -> typename std::iterator_traits<I>::value_type {
+    return *i;
+}
+
+double Add(double x, double y) {
+    return x + y;
+}
+}
+
+TEST(IteratorsTest, reduce_interleaved_int) {
+    for (int n = 0; n < 100; ++n) {
+        std::vector<int> v(n);
+        std::iota(begin(v), end(v), 1);
+        const std::list<int> l(begin(v), end(v));
+        const int expected = n * (n + 1) / 2;
+        EXPECT_EQ(ReduceInterleaved(begin(v), end(v), Accumulate, Value<std::vector<int>::iterator>, 0), expected) << n;
+        EXPECT_EQ(ReduceInterleaved<1>(begin(v), end(v), Accumulate, Value<std::vector<int>::iterator>, 0), expected) << n;
+        EXPECT_EQ(ReduceInterleaved<7>(begin(v), end(v), Accumulate, Value<std::vector<int>::iterator>, 0), expected) << n;
+        EXPECT_EQ(ReduceInterleaved<8>(begin(l), end(l), Accumulate, Value<std::list<int>::const_iterator>, 0), expected) << n;
+    }
+}
+
+TEST(IteratorsTest, floating_point_reductions_are_more_accurate_than_left_fold) {
+    const std::vector<double> v(1000000, 0.1);
+    const double exact = 100000.0;
+    using It = std::vector<double>::const_iterator;
+    const double left = Reduce(begin(v), end(v), Add, Value<It>, 0.0);
+    const double interleaved = ReduceInterleaved<8>(begin(v), end(v), Add, Value<It>, 0.0);
+    const double compensated = SumCompensated(begin(v), end(v), Value<It>, 0.0);
+
+    EXPECT_LT(std::abs(interleaved - exact), std::abs(left - exact));
+    EXPECT_DOUBLE_EQ(compensated, exact);
+}
+
+TEST(IteratorsTest, sum_compensated_recovers_cancelled_terms) {
+    const std::vector<double> v = { 1.0, 1e100, 1.0, -1e100 };
+    using It = std::vector<double>::const_iterator;
+    EXPECT_EQ(Reduce(begin(v), end(v), Add, Value<It>, 0.0), 0.0);
+    EXPECT_EQ(SumCompensated(begin(v), end(v), Value<It>, 0.0), 2.0);
+}
+
+namespace {
+struct CopyCounted {
+    CopyCounted() = default;
+    explicit CopyCounted(std::string s)
+          : s(std::move(s)) {}
+    CopyCounted(const CopyCounted& x)
+          : s(x.s) { ++copies; }
+    CopyCounted(CopyCounted&&) = default;
+    CopyCounted& operator=(const CopyCounted& x) {
+        s = x.s;
+        ++copies;
+        return *this;
+    }
+    CopyCounted& operator=(CopyCounted&&) = default;
+
+    std::string s;
+    static inline int copies = 0;
+};
+
+CopyCounted Append(CopyCounted x, const CopyCounted& y) {
+    x.s += y.s;
+    return x;
+}
+
+template <typename I>
+CopyCounted ToCopyCounted(I i) {
+    return CopyCounted(std::to_string(*i));
+}
+
+struct CopyCountedAppender {
+    void operator()(int x) { r.s += std::to_string(x); }
+    CopyCounted r;
+};
+}
+
+TEST(IteratorsTest, reduce_moves_the_accumulator) {
+    const std::vector<int> v = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    CopyCounted::copies = 0;
+    EXPECT_EQ(ReduceNonEmpty(begin(v), end(v), Append, ToCopyCounted<std::vector<int>::const_iterator>).s, "123456789");
+    EXPECT_EQ(Reduce(begin(v), end(v), Append, ToCopyCounted<std::vector<int>::const_iterator>, CopyCounted()).s, "123456789");
+    EXPECT_EQ(CopyCounted::copies, 0);
+}
+
+TEST(IteratorsTest, for_each_moves_the_procedure) {
+    const std::vector<int> v = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    CopyCounted::copies = 0;
+    EXPECT_EQ(ForEach(begin(v), end(v), CopyCountedAppender()).r.s, "123456789");
+    EXPECT_EQ(CopyCounted::copies, 0);
+}
+
+TEST(IteratorsTest, find_unguarded) {
+    const std::vector<int> v = { 21, 22, 23, 24, 25 };
+    EXPECT_EQ(FindUnguarded(begin(v), 23), begin(v) + 2);
+    EXPECT_EQ(FindUnguarded(begin(v), 21), begin(v));
+    EXPECT_EQ(FindIfUnguarded(begin(v), IsEqualTo(25)), begin(v) + 4);
+}
+
+TEST(IteratorsTest, find_sentinel_restores_spare_slot) {
+    std::vector<int> v = { 21, 22, 23, 24, 25, -1 };
+    const auto l = end(v) - 1;
+    EXPECT_EQ(FindSentinel(begin(v), l, 23), begin(v) + 2);
+    EXPECT_EQ(FindSentinel(begin(v), l, 21), begin(v));
+    EXPECT_EQ(FindSentinel(begin(v), l, 25), begin(v) + 4);
+    EXPECT_EQ(FindSentinel(begin(v), l, 26), l);
+    EXPECT_EQ(FindSentinel(l, l, 21), l);
+    EXPECT_EQ(v.back(), -1);
+}
+
+TEST(IteratorsTest, find_if_sentinel_restores_spare_slot) {
+    std::vector<std::string> v = { "21", "22", "23", "spare" };
+    const auto l = end(v) - 1;
+    EXPECT_EQ(FindIfSentinel(begin(v), l, IsEqualTo<std::string>("22"), "22"), begin(v) + 1);
+    EXPECT_EQ(FindIfSentinel(begin(v), l, IsEqualTo<std::string>("24"), "24"), l);
+    EXPECT_EQ(v.back(), "spare");
+}
+
+TEST(IteratorsTest, sentinel_range_with_other_algorithms) {
+    const char text[] = "hello, world";
+    const auto r = SentinelRange(text, '\0');
+    EXPECT_EQ(ForEach(r.first, r.second, Counter()).cnt, 12);
+    EXPECT_EQ(CountIf(r.first, r.second, IsEqualTo('o'), 0), 2);
+    EXPECT_EQ(Find(r.first, r.second, ',').Base(), text + 5);
+    EXPECT_EQ(Find(r.first, r.second, 'x'), r.second);
+    EXPECT_EQ(Find(r.first, r.second, 'x').Base(), text + 12);
+
+    const std::vector<int> v = { 3, 1, 4, 1, 5, 0, 9, 2 };
+    const auto z = SentinelRange(begin(v), 0);
+    EXPECT_EQ(Reduce(z.first, z.second, Accumulate, Value<SentinelIterator<std::vector<int>::const_iterator>>, 0), 14);
+}
+
+TEST(IteratorsTest, partition_point) {
+    const std::vector<int> v = { 1, 3, 5, 7, 2, 4, 6 };
+    auto even = [](int x) { return x % 2 == 0; };
+    EXPECT_EQ(PartitionPoint(begin(v), end(v), even), begin(v) + 4);
+    EXPECT_EQ(PartitionPoint(begin(v), begin(v) + 4, even), begin(v) + 4);
+    EXPECT_EQ(PartitionPoint(begin(v) + 4, end(v), even), begin(v) + 4);
+    EXPECT_EQ(PartitionPointN(begin(v), 0, even), begin(v));
+}
+
+TEST(IteratorsTest, lower_and_upper_bound) {
+    const std::vector<int> v = { 1, 2, 2, 2, 5, 8, 8, 9 };
+    const std::list<int> l(begin(v), end(v));
+    const auto less = std::less<int>();
+    for (int x = 0; x <= 10; ++x) {
+        EXPECT_EQ(LowerBound(begin(v), end(v), x, less), std::lower_bound(begin(v), end(v), x)) << x;
+        EXPECT_EQ(UpperBound(begin(v), end(v), x, less), std::upper_bound(begin(v), end(v), x)) << x;
+        EXPECT_EQ(LowerBound(begin(l), end(l), x, less), std::lower_bound(begin(l), end(l), x)) << x;
+        EXPECT_EQ(UpperBound(begin(l), end(l), x, less), std::upper_bound(begin(l), end(l), x)) << x;
+    }
+}
+
+TEST(IteratorsTest, count_if_each_in_one_pass) {
+    const std::vector<int> v = { 1, 2, 1, 3, 7, -4, 0 };
+    const auto ps = std::make_tuple(IsEqualTo(1), [](int x) { return x < 0; }, [](int x) { return x % 2 == 1; });
+    const std::array<int, 3> expected = { 2, 1, 4 };
+    EXPECT_EQ(CountIfEach(begin(v), end(v), ps, std::array<int, 3>{}), expected);
+
+    const std::array<int, 3> start = { 10, 20, 30 };
+    const std::array<int, 3> expected_from_start = { 12, 21, 34 };
+    EXPECT_EQ(CountIfEach(begin(v), end(v), ps, start), expected_from_start);
+
+    const std::list<int> empty;
+    EXPECT_EQ(CountIfEach(begin(empty), end(empty), ps, start), start);
+}
+
+template <typename T>
+void CheckLanewiseCounts(T low, T high) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dis{ int(low), int(high) };
+    for (std::size_t n : { 0, 1, 15, 16, 17, 100, 2031, 2032, 2033, 40000 }) {
+        std::vector<T> v(n);
+        for (auto& x : v)
+            x = T(dis(gen));
+        const auto lanewise = std::make_tuple(LessThan<T>(T(0)), GreaterThan<T>(T(high / 2)), EqualTo<T>(T(1)));
+        const auto scalar = std::make_tuple([](T x) { return x < T(0); }, [high](T x) { return x > T(high / 2); }, [](T x) { return x == T(1); });
+        // the lambdas are not Lanewise: element by element
+        const auto reference = CountIfEach(begin(v), end(v), scalar, std::array<std::size_t, 3>{});
+        EXPECT_EQ(CountIfEach(begin(v), end(v), lanewise, std::array<std::size_t, 3>{}), reference) << n;
+        EXPECT_EQ(CountIfEach(v.data(), v.data() + n, lanewise, std::array<std::size_t, 3>{}), reference) << n;
+        EXPECT_EQ(CountIfEachParallel(begin(v), end(v), lanewise, std::array<std::size_t, 3>{}, 3), reference) << n;
+    }
+}
+
+TEST(IteratorsTest, count_if_each_lanewise_agrees_with_scalar) {
+    CheckLanewiseCounts<std::int8_t>(-128, 127);
+    CheckLanewiseCounts<std::uint8_t>(0, 255);
+    CheckLanewiseCounts<std::int16_t>(-1000, 1000);
+    CheckLanewiseCounts<int>(-1000, 1000);
+    CheckLanewiseCounts<long>(-1000, 1000);
+    CheckLanewiseCounts<float>(-100, 100);
+    CheckLanewiseCounts<double>(-100, 100);
+}
+
+TEST(IteratorsTest, count_buckets) {
+    const std::vector<int> v = { 1, 2, 1, 3, 7, 4, 0 };
+    std::vector<int> histogram(3, 0);
+    CountBuckets(begin(v), end(v), [](int x) { return x % 3; }, histogram.begin());
+    EXPECT_EQ(histogram, std::vector<int>({ 2, 4, 1 }));
+}
+
+TEST(IteratorsTest, parallel_counts_agree_with_serial) {
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<> dis(-1000, 1000);
+    for (std::size_t n : { 0, 1, 7, 100, 100001 }) {
+        std::vector<int> v(n);
+        for (auto& x : v)
+            x = dis(gen);
+        const auto ps = std::make_tuple([](int x) { return x < 0; }, [](int x) { return x > 500; }, IsEqualTo(0));
+        const auto serial = CountIfEach(begin(v), end(v), ps, std::array<std::size_t, 3>{});
+        EXPECT_EQ(serial[0], static_cast<std::size_t>(CountIf(begin(v), end(v), std::get<0>(ps), 0)));
+        EXPECT_EQ(serial[1], static_cast<std::size_t>(CountIf(begin(v), end(v), std::get<1>(ps), 0)));
+        for (unsigned threads : { 1U, 3U, 8U })
+            EXPECT_EQ(CountIfEachParallel(begin(v), end(v), ps, std::array<std::size_t, 3>{}, threads), serial) << n;
+
+        auto bucket = [](int x) { return static_cast<std::size_t>(x + 1000) / 100; };
+        std::vector<long> histogram(21, 0);
+        CountBuckets(begin(v), end(v), bucket, histogram.begin());
+        for (unsigned threads : { 1U, 4U }) {
+            std::vector<long> parallel(21, 0);
+            CountBucketsParallel(begin(v), end(v), bucket, 21, parallel.begin(), threads);
+            EXPECT_EQ(parallel, histogram) << n;
+        }
+    }
+}
 }
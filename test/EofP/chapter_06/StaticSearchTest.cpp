@@ -0,0 +1,106 @@
+#include "EofP/chapter_06/StaticSearch.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace EofP {
+
+namespace {
+std::vector<int> sorted_random(std::size_t n, std::mt19937& gen) {
+    std::uniform_int_distribution<> dis(0, static_cast<int>(n));
+    std::vector<int> v(n);
+    for (auto& x : v)
+        x = 2 * dis(gen);
+    std::sort(begin(v), end(v));
+    return v;
+}
+
+// compares the values found, as the layouts keep their own copies
+template <typename S, typename T>
+void check_search(const S& s, const std::vector<T>& v, const T& x) {
+    const auto lb = std::lower_bound(begin(v), end(v), x);
+    const T* l = s.LowerBound(x);
+    ASSERT_EQ(l == nullptr, lb == end(v)) << x;
+    if (l != nullptr)
+        EXPECT_EQ(*l, *lb) << x;
+
+    const auto ub = std::upper_bound(begin(v), end(v), x);
+    const T* u = s.UpperBound(x);
+    ASSERT_EQ(u == nullptr, ub == end(v)) << x;
+    if (u != nullptr)
+        EXPECT_EQ(*u, *ub) << x;
+}
+}
+
+TEST(StaticSearchTest, cache_line_allocation) {
+    for (std::size_t n : { 1, 3, 17, 1000 }) {
+        const CacheLineVector<char> c(n);
+        const CacheLineVector<double> d(n);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(c.data()) % 64, 0U) << n;
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(d.data()) % 64, 0U) << n;
+    }
+}
+
+TEST(StaticSearchTest, eytzinger_empty) {
+    const std::vector<int> v;
+    const EytzingerLayout<int> s(begin(v), end(v));
+    EXPECT_EQ(s.Size(), 0);
+    EXPECT_EQ(s.LowerBound(3), nullptr);
+    EXPECT_EQ(s.UpperBound(3), nullptr);
+}
+
+TEST(StaticSearchTest, btree_empty) {
+    const std::vector<int> v;
+    const BTreeLayout<int> s(begin(v), end(v));
+    EXPECT_EQ(s.Size(), 0);
+    EXPECT_EQ(s.LowerBound(3), nullptr);
+    EXPECT_EQ(s.UpperBound(3), nullptr);
+}
+
+TEST(StaticSearchTest, eytzinger_agrees_with_bisection) {
+    std::mt19937 gen(1);
+    for (std::size_t n = 1; n < 300; ++n) {
+        const auto v = sorted_random(n, gen);
+        const EytzingerLayout<int> s(begin(v), end(v));
+        EXPECT_EQ(s.Size(), n);
+        for (int x = -1; x <= 2 * static_cast<int>(n) + 1; ++x)
+            check_search(s, v, x);
+    }
+}
+
+TEST(StaticSearchTest, btree_agrees_with_bisection) {
+    std::mt19937 gen(2);
+    for (std::size_t n = 1; n < 300; ++n) {
+        const auto v = sorted_random(n, gen);
+        const BTreeLayout<int> s16(begin(v), end(v));
+        const BTreeLayout<int, 3> s3(begin(v), end(v));
+        EXPECT_EQ(s16.Size(), n);
+        for (int x = -1; x <= 2 * static_cast<int>(n) + 1; ++x) {
+            check_search(s16, v, x);
+            check_search(s3, v, x);
+        }
+    }
+}
+
+TEST(StaticSearchTest, with_relation) {
+    const std::vector<std::string> v = { "pear", "kiwi", "fig", "banana", "apple" };
+    const auto greater = std::greater<std::string>();
+    const EytzingerLayout<std::string, std::greater<std::string>> e(begin(v), end(v), greater);
+    const BTreeLayout<std::string, 2, std::greater<std::string>> b(begin(v), end(v), greater);
+
+    EXPECT_EQ(*e.LowerBound("kiwi"), "kiwi");
+    EXPECT_EQ(*e.LowerBound("grape"), "fig");
+    EXPECT_EQ(*e.UpperBound("kiwi"), "fig");
+    EXPECT_EQ(e.LowerBound("aardvark"), nullptr);
+
+    EXPECT_EQ(*b.LowerBound("kiwi"), "kiwi");
+    EXPECT_EQ(*b.LowerBound("grape"), "fig");
+    EXPECT_EQ(*b.UpperBound("kiwi"), "fig");
+    EXPECT_EQ(b.LowerBound("aardvark"), nullptr);
+}
+}
@@ -0,0 +1,112 @@
+#include "EofP/chapter_06/Views.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace EofP {
+
+namespace {
+bool IsOdd(int x) {
+    return x % 2 != 0;
+}
+
+int Square(int x) {
+    return x * x;
+}
+
+int Add(int x, int y) {
+    return x + y;
+}
+}
+
+TEST(ViewsTest, range_of_container) {
+    const std::vector<int> v = { 1, 2, 3 };
+    const auto r = MakeRange(v);
+    EXPECT_EQ(r.begin(), begin(v));
+    EXPECT_EQ(r.end(), end(v));
+    EXPECT_EQ(Reduce(r, Add, 0), 6);
+}
+
+TEST(ViewsTest, transform) {
+    const std::vector<int> v = { 1, 2, 3, 4 };
+    const auto r = Transform(MakeRange(v), Square);
+    EXPECT_EQ(ReduceNonEmpty(r, Add), 30);
+
+    std::vector<int> out;
+    for (int x : r)
+        out.push_back(x);
+    EXPECT_EQ(out, std::vector<int>({ 1, 4, 9, 16 }));
+}
+
+TEST(ViewsTest, filter) {
+    const std::list<int> v = { 2, 1, 4, 3, 6, 5, 8 };
+    const auto r = Filter(MakeRange(v), IsOdd);
+    EXPECT_EQ(Reduce(r, Add, 0), 9);
+    EXPECT_EQ(CountIf(r, [](int x) { return x > 1; }, 0), 2);
+
+    const auto none = Filter(MakeRange(v), [](int x) { return x > 100; });
+    EXPECT_EQ(none.begin(), none.end());
+    EXPECT_EQ(Reduce(none, Add, -1), -1);
+}
+
+TEST(ViewsTest, take_while) {
+    const std::vector<int> v = { 1, 3, 5, 6, 7, 9 };
+    const auto r = TakeWhile(MakeRange(v), IsOdd);
+    EXPECT_EQ(Reduce(r, Add, 0), 9);
+
+    const auto all = TakeWhile(MakeRange(v), [](int x) { return x < 100; });
+    EXPECT_EQ(Reduce(all, Add, 0), 31);
+
+    const auto none = TakeWhile(MakeRange(v), [](int x) { return x > 100; });
+    EXPECT_EQ(none.begin(), none.end());
+}
+
+TEST(ViewsTest, take_while_applies_predicate_once_per_element) {
+    const std::vector<int> v = { 1, 3, 5, 6, 7, 9 };
+    int calls = 0;
+    const auto r = TakeWhile(MakeRange(v), [&calls](int x) {
+        ++calls;
+        return IsOdd(x);
+    });
+    EXPECT_EQ(CountIf(r, IsOdd, 0), 3);
+    EXPECT_EQ(calls, 4);
+}
+
+TEST(ViewsTest, zip_stops_at_shortest) {
+    const std::vector<int> v0 = { 1, 2, 3, 4 };
+    const std::vector<std::string> v1 = { "a", "b", "c" };
+    const auto r = Zip(MakeRange(v0), MakeRange(v1));
+    std::string joined;
+    ForEach(r, [&joined](const std::pair<const int&, const std::string&>& p) {
+        joined += std::to_string(p.first) + p.second;
+    });
+    EXPECT_EQ(joined, "1a2b3c");
+}
+
+TEST(ViewsTest, zip_agrees_with_find_mismatch) {
+    const std::vector<int> v0 = { 5, 7, 9, 12 };
+    const std::vector<int> v1 = { 5, 7, 8, 12 };
+    auto differ = [](const auto& p) { return p.first != p.second; };
+    const auto r = Zip(MakeRange(v0), MakeRange(v1));
+    EXPECT_EQ(FindIf(r.begin(), r.end(), differ).Base(),
+          FindMismatch(begin(v0), end(v0), begin(v1), end(v1), std::equal_to<int>()));
+    EXPECT_EQ(CountIf(r, differ, 0), 1);
+}
+
+TEST(ViewsTest, pipeline_fuses_stages) {
+    const std::vector<int> v = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    std::vector<int> reads;
+    const auto counted = Transform(MakeRange(v), [&reads](int x) {
+        reads.push_back(x);
+        return x;
+    });
+    const auto r = Transform(Filter(TakeWhile(counted, [](int x) { return x < 8; }), IsOdd), Square);
+    EXPECT_EQ(Reduce(r, Add, 0), 1 + 9 + 25 + 49);
+    // each element is transformed once, up to the first one failing TakeWhile
+    EXPECT_EQ(reads, std::vector<int>({ 1, 2, 3, 4, 5, 6, 7, 8 }));
+}
+}
@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
 #include <vector>
 
 namespace EofP {
@@ -185,6 +187,127 @@ TEST(BifurcateCoordinateTest, traverse_nonempty_counting_strings) {
     EXPECT_NE(proc.count.find("r r"), proc.count.end());
 }
 
+namespace {
+struct CopyCountedVisitor {
+    CopyCountedVisitor() = default;
+    CopyCountedVisitor(const CopyCountedVisitor& x)
+          : visits(x.visits) { ++copies; }
+    CopyCountedVisitor(CopyCountedVisitor&&) = default;
+    CopyCountedVisitor& operator=(const CopyCountedVisitor& x) {
+        visits = x.visits;
+        ++copies;
+        return *this;
+    }
+    CopyCountedVisitor& operator=(CopyCountedVisitor&&) = default;
+    void operator()(Visit visit, BifurcateCoordinate<int> c) {
+        if (visit == Visit::PRE)
+            visits.push_back(*c);
+    }
+
+    std::vector<int> visits;
+    static inline int copies = 0;
+};
+}
+
+TEST(BifurcateCoordinateTest, traverse_nonempty_moves_the_procedure) {
+    BinaryNode<int> root(0);
+    const BifurcateCoordinate<int> i(root);
+
+    auto& l = root.AddLeftSuccessor(1);
+    auto& r = root.AddRightSuccessor(2);
+
+    l.AddLeftSuccessor(11);
+    l.AddRightSuccessor(12);
+    r.AddLeftSuccessor(21);
+    r.AddRightSuccessor(22);
+
+    CopyCountedVisitor::copies = 0;
+    const auto proc = TraverseNonempty(i, CopyCountedVisitor());
+    EXPECT_EQ(proc.visits, std::vector<int>({ 0, 1, 11, 12, 2, 21, 22 }));
+    EXPECT_EQ(CopyCountedVisitor::copies, 0);
+}
+
+namespace {
+void grow_random_tree(BinaryNode<int>& node, std::mt19937& gen, int depth) {
+    if (depth == 0)
+        return;
+    std::uniform_int_distribution<> dis(0, 3);
+    const int children = dis(gen);
+    if (children & 1)
+        grow_random_tree(node.AddLeftSuccessor(2 * *BifurcateCoordinate<int>(node)), gen, depth - 1);
+    if (children & 2)
+        grow_random_tree(node.AddRightSuccessor(2 * *BifurcateCoordinate<int>(node) + 1), gen, depth - 1);
+}
+
+struct VisitRecorder {
+    void operator()(Visit visit, BifurcateCoordinate<int> c) {
+        visits.emplace_back(visit, *c);
+    }
+    std::vector<std::pair<Visit, int>> visits;
+};
+}
+
+TEST(BifurcateCoordinateTest, traverse_nonempty_prefetch_same_visits) {
+    std::mt19937 gen(42);
+    for (int k = 0; k < 20; ++k) {
+        BinaryNode<int> root(1);
+        grow_random_tree(root, gen, 12);
+        const BifurcateCoordinate<int> i(root);
+        EXPECT_EQ(TraverseNonemptyPrefetch(i, VisitRecorder()).visits, TraverseNonempty(i, VisitRecorder()).visits);
+    }
+}
+
+namespace {
+using DepthVisits = std::vector<std::pair<const int*, int>>;
+
+void recursive_visits(BifurcateCoordinate<int> c, int depth, DepthVisits& visits) {
+    visits.emplace_back(&*c, depth);
+    if (c.HasLeftSuccessor())
+        recursive_visits(c.LeftSuccessor(), depth + 1, visits);
+    if (c.HasRightSuccessor())
+        recursive_visits(c.RightSuccessor(), depth + 1, visits);
+}
+
+template <std::size_t Lanes>
+DepthVisits sorted_prefetch_visits(BifurcateCoordinate<int> c) {
+    DepthVisits visits;
+    TraversePrefetch<Lanes>(c, [&visits](BifurcateCoordinate<int> x, int depth) { visits.emplace_back(&*x, depth); });
+    std::sort(begin(visits), end(visits));
+    return visits;
+}
+}
+
+TEST(BifurcateCoordinateTest, traverse_prefetch_visits_each_node_once) {
+    std::mt19937 gen(3);
+    for (int k = 0; k < 20; ++k) {
+        BinaryNode<int> root(1);
+        grow_random_tree(root, gen, 12);
+        const BifurcateCoordinate<int> i(root);
+
+        DepthVisits expected;
+        recursive_visits(i, 1, expected);
+        std::sort(begin(expected), end(expected));
+        EXPECT_EQ(sorted_prefetch_visits<1>(i), expected);
+        EXPECT_EQ(sorted_prefetch_visits<2>(i), expected);
+        EXPECT_EQ(sorted_prefetch_visits<8>(i), expected);
+    }
+}
+
+TEST(BifurcateCoordinateTest, weight_and_height_prefetch) {
+    const BifurcateCoordinate<int> empty;
+    EXPECT_EQ(WeightPrefetch(empty), 0);
+    EXPECT_EQ(HeightPrefetch(empty), 0);
+
+    std::mt19937 gen(7);
+    for (int k = 0; k < 20; ++k) {
+        BinaryNode<int> root(1);
+        grow_random_tree(root, gen, 14);
+        const BifurcateCoordinate<int> i(root);
+        EXPECT_EQ(WeightPrefetch(i), WeightRecursive(i));
+        EXPECT_EQ(HeightPrefetch(i), HeightRecursive(i));
+    }
+}
+
 TEST(BidirectionalBifurcateCoordinateTest, build_tree_2_levels_string) {
     BidirectionalBinaryNode<std::string> root("root string");
     const BidirectionalBifurcateCoordinate<std::string> i(root);
@@ -0,0 +1,100 @@
+#include "EofP/chapter_07/HashConsedTree.h"
+#include "PreorderRecorder.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EofP {
+
+namespace {
+template <typename T>
+HashConsedCoordinate<T> complete_tree(HashConsedTreeBuilder<T>& builder, int height, const T& t) {
+    if (height == 0)
+        return HashConsedCoordinate<T>();
+    const auto c = complete_tree(builder, height - 1, t);
+    return builder.Make(t, c, c);
+}
+}
+
+TEST(HashConsedTreeTest, empty_tree) {
+    const HashConsedCoordinate<int> c;
+    EXPECT_TRUE(c.Empty());
+    EXPECT_EQ(WeightRecursive(c), 0U);
+    EXPECT_EQ(HeightRecursive(c), 0);
+}
+
+TEST(HashConsedTreeTest, identical_subtrees_are_shared) {
+    HashConsedTreeBuilder<std::string> builder;
+    const auto a = builder.Make("l", builder.Make("x"), builder.Make("y"));
+    const auto b = builder.Make("l", builder.Make("x"), builder.Make("y"));
+    const auto c = builder.Make("l", builder.Make("y"), builder.Make("x"));
+
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(builder.DistinctNodes(), 4);
+
+    const auto root = builder.Make("root", a, c);
+    EXPECT_EQ(root.LeftSuccessor().LeftSuccessor(), root.RightSuccessor().RightSuccessor());
+    EXPECT_EQ(*root.LeftSuccessor().RightSuccessor(), "y");
+    EXPECT_EQ(builder.DistinctNodes(), 5);
+}
+
+TEST(HashConsedTreeTest, memory_scales_with_distinct_subtrees) {
+    HashConsedTreeBuilder<int> builder;
+    const auto c = complete_tree(builder, 30, 7);
+
+    EXPECT_EQ(builder.DistinctNodes(), 30);
+    EXPECT_EQ(WeightRecursive(c), (std::uint64_t(1) << 30) - 1);
+    EXPECT_EQ(HeightRecursive(c), 30);
+}
+
+TEST(HashConsedTreeTest, weight_beyond_int_range) {
+    HashConsedTreeBuilder<int> builder;
+    const auto c33 = complete_tree(builder, 33, 7);
+    const auto c63 = complete_tree(builder, 63, 7);
+
+    EXPECT_EQ(builder.DistinctNodes(), 63);
+    EXPECT_EQ(WeightRecursive(c33), (std::uint64_t(1) << 33) - 1);
+    EXPECT_EQ(HeightRecursive(c33), 33);
+    EXPECT_EQ(WeightRecursive(c63), (std::uint64_t(1) << 63) - 1);
+    EXPECT_EQ(HeightRecursive(c63), 63);
+}
+
+TEST(HashConsedTreeTest, weight_and_height_agree_with_traversal) {
+    HashConsedTreeBuilder<int> builder;
+    const auto c = builder.Make(0, complete_tree(builder, 4, 1), builder.Make(2, HashConsedCoordinate<int>(), complete_tree(builder, 2, 3)));
+
+    EXPECT_EQ(WeightRecursive(c), 1U + 15 + 1 + 3);
+    EXPECT_EQ(HeightRecursive(c), 5);
+    EXPECT_EQ(static_cast<std::uint64_t>(WeightPrefetch(c)), WeightRecursive(c));
+    EXPECT_EQ(HeightPrefetch(c), HeightRecursive(c));
+
+    const auto proc = TraverseNonempty(c, PreorderRecorder<HashConsedCoordinate<int>>());
+    const std::vector<int> expected = { 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 3, 3, 3 };
+    EXPECT_EQ(proc.values, expected);
+}
+
+TEST(HashConsedTreeTest, intern_binary_node_tree) {
+    BinaryNode<std::string> root("root");
+    auto& l = root.AddLeftSuccessor("x");
+    auto& r = root.AddRightSuccessor("x");
+    l.AddLeftSuccessor("leaf");
+    l.AddRightSuccessor("leaf");
+    r.AddLeftSuccessor("leaf");
+    r.AddRightSuccessor("leaf");
+    const BifurcateCoordinate<std::string> i(root);
+
+    HashConsedTreeBuilder<std::string> builder;
+    const auto c = builder.Intern(i);
+
+    EXPECT_EQ(builder.DistinctNodes(), 3);
+    EXPECT_EQ(WeightRecursive(c), static_cast<std::uint64_t>(WeightRecursive(i)));
+    EXPECT_EQ(HeightRecursive(c), HeightRecursive(i));
+    EXPECT_EQ(TraverseNonempty(c, PreorderRecorder<HashConsedCoordinate<std::string>>()).values,
+          TraverseNonempty(i, PreorderRecorder<BifurcateCoordinate<std::string>>()).values);
+    EXPECT_EQ(builder.Intern(BifurcateCoordinate<std::string>(l)), c.LeftSuccessor());
+}
+}
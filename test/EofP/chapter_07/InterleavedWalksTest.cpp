@@ -0,0 +1,122 @@
+#include "EofP/chapter_07/InterleavedWalks.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace EofP {
+
+namespace {
+// complete search tree with the keys 2 * lo ... 2 * (hi - 1)
+template <typename N>
+void grow_search_tree(N& node, int lo, int hi) {
+    const int m = lo + (hi - lo) / 2;
+    if (lo < m)
+        grow_search_tree(node.AddLeftSuccessor(2 * (lo + (m - lo) / 2)), lo, m);
+    if (m + 1 < hi)
+        grow_search_tree(node.AddRightSuccessor(2 * (m + 1 + (hi - m - 1) / 2)), m + 1, hi);
+}
+
+struct SearchStep {
+    template <typename C>
+    std::optional<Direction> operator()(int key, C c) const {
+        if (key == *c)
+            return std::nullopt;
+        return key < *c ? Direction::LEFT : Direction::RIGHT;
+    }
+};
+
+template <typename C>
+C descend(C c, int key) {
+    while (true) {
+        const std::optional<Direction> d = SearchStep()(key, c);
+        if (d == Direction::LEFT && c.HasLeftSuccessor())
+            c = c.LeftSuccessor();
+        else if (d == Direction::RIGHT && c.HasRightSuccessor())
+            c = c.RightSuccessor();
+        else
+            return c;
+    }
+}
+
+template <typename C>
+std::vector<C> all_coordinates(C root) {
+    std::vector<C> cs;
+    TraversePrefetch(root, [&cs](C c, int) { cs.push_back(c); });
+    return cs;
+}
+}
+
+TEST(InterleavedWalksTest, descend_interleaved_agrees_with_sequential_descent) {
+    constexpr int n = 1000;
+    BinaryNode<int> root(2 * (n / 2));
+    grow_search_tree(root, 0, n);
+    const BifurcateCoordinate<int> iroot(root);
+
+    std::vector<int> keys;
+    for (int k = -3; k < 2 * n + 3; ++k)
+        keys.push_back(k);
+    std::shuffle(begin(keys), end(keys), std::mt19937(3));
+
+    std::vector<int> found(keys.size(), -1);
+    int count = 0;
+    DescendInterleaved(iroot, begin(keys), end(keys), SearchStep(),
+          [&](std::vector<int>::iterator q, BifurcateCoordinate<int> c) {
+              found[q - begin(keys)] = *c;
+              ++count;
+          });
+
+    EXPECT_EQ(count, static_cast<int>(keys.size()));
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(found[i], *descend(iroot, keys[i])) << keys[i];
+        if (keys[i] >= 0 && keys[i] < 2 * n && keys[i] % 2 == 0)
+            EXPECT_EQ(found[i], keys[i]);
+    }
+}
+
+TEST(InterleavedWalksTest, descend_interleaved_fewer_queries_than_walks) {
+    BinaryNode<int> root(4);
+    grow_search_tree(root, 0, 5);
+    const BifurcateCoordinate<int> iroot(root);
+
+    const std::vector<int> keys = { 6, 0 };
+    std::vector<int> found;
+    DescendInterleaved<16>(iroot, begin(keys), end(keys), SearchStep(),
+          [&found](std::vector<int>::const_iterator, BifurcateCoordinate<int> c) { found.push_back(*c); });
+    std::sort(begin(found), end(found));
+    EXPECT_EQ(found, std::vector<int>({ 0, 6 }));
+
+    const std::vector<int> none;
+    DescendInterleaved(iroot, begin(none), end(none), SearchStep(),
+          [](std::vector<int>::const_iterator, BifurcateCoordinate<int>) { FAIL(); });
+}
+
+TEST(InterleavedWalksTest, reachable_interleaved_agrees_with_reachable) {
+    using C = BidirectionalBifurcateCoordinate<int>;
+    BidirectionalBinaryNode<int> root1(2 * (30 / 2));
+    grow_search_tree(root1, 0, 30);
+    BidirectionalBinaryNode<int> root2(2 * (20 / 2));
+    grow_search_tree(root2, 0, 20);
+
+    auto cs = all_coordinates(C(root1));
+    const auto cs2 = all_coordinates(C(root2));
+    cs.insert(end(cs), begin(cs2), end(cs2));
+    cs.push_back(C());
+
+    std::vector<std::pair<C, C>> queries;
+    for (const auto& x : cs)
+        for (const auto& y : cs)
+            queries.emplace_back(x, y);
+
+    std::vector<int> result(queries.size(), -1);
+    ReachableInterleaved<4>(begin(queries), end(queries),
+          [&](std::vector<std::pair<C, C>>::iterator q, bool r) { result[q - begin(queries)] = r; });
+
+    for (std::size_t i = 0; i < queries.size(); ++i)
+        EXPECT_EQ(result[i], Reachable(queries[i].first, queries[i].second) ? 1 : 0) << i;
+}
+}
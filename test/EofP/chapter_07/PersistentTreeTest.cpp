@@ -0,0 +1,112 @@
+#include "EofP/chapter_07/PersistentTree.h"
+#include "PreorderRecorder.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace EofP {
+
+TEST(PersistentTreeTest, empty_tree) {
+    const PersistentTree<int> tree;
+    const auto s = tree.Read();
+    EXPECT_TRUE(s.Root().Empty());
+    EXPECT_EQ(WeightRecursive(s.Root()), 0);
+    EXPECT_EQ(HeightRecursive(s.Root()), 0);
+}
+
+TEST(PersistentTreeTest, snapshots_are_not_affected_by_updates) {
+    PersistentTree<std::string> tree;
+    tree.SetRoot("root");
+    const auto s1 = tree.Read();
+
+    tree.AddLeftSuccessor({}, "l");
+    tree.AddRightSuccessor({}, "r");
+    tree.AddLeftSuccessor({ Direction::LEFT }, "l l");
+    const auto s2 = tree.Read();
+
+    tree.SetValue({ Direction::LEFT }, "L");
+    tree.AddRightSuccessor({ Direction::RIGHT }, "r r");
+    const auto s3 = tree.Read();
+
+    EXPECT_EQ(WeightRecursive(s1.Root()), 1);
+    EXPECT_EQ(HeightRecursive(s1.Root()), 1);
+    EXPECT_EQ(*s1.Root(), "root");
+
+    using Recorder = PreorderRecorder<PersistentCoordinate<std::string>>;
+    EXPECT_EQ(WeightRecursive(s2.Root()), 4);
+    EXPECT_EQ(HeightRecursive(s2.Root()), 3);
+    EXPECT_EQ(TraverseNonempty(s2.Root(), Recorder()).values, std::vector<std::string>({ "root", "l", "l l", "r" }));
+
+    EXPECT_EQ(WeightRecursive(s3.Root()), 5);
+    EXPECT_EQ(TraverseNonempty(s3.Root(), Recorder()).values, std::vector<std::string>({ "root", "L", "l l", "r", "r r" }));
+
+    // unchanged subtrees are shared between versions
+    EXPECT_EQ(s2.Root().LeftSuccessor().LeftSuccessor(), s3.Root().LeftSuccessor().LeftSuccessor());
+    EXPECT_NE(s2.Root().LeftSuccessor(), s3.Root().LeftSuccessor());
+}
+
+TEST(PersistentTreeTest, replacing_a_subtree) {
+    PersistentTree<int> tree;
+    tree.SetRoot(0);
+    tree.AddLeftSuccessor({}, 1);
+    tree.AddLeftSuccessor({ Direction::LEFT }, 2);
+    tree.AddRightSuccessor({ Direction::LEFT }, 3);
+    EXPECT_EQ(WeightRecursive(tree.Read().Root()), 4);
+
+    tree.AddLeftSuccessor({}, 4);
+    EXPECT_EQ(WeightRecursive(tree.Read().Root()), 2);
+    tree.Reclaim();
+
+    tree.SetRoot(5);
+    const auto s = tree.Read();
+    EXPECT_EQ(WeightRecursive(s.Root()), 1);
+    EXPECT_EQ(*s.Root(), 5);
+}
+
+TEST(PersistentTreeTest, concurrent_readers_see_consistent_versions) {
+    // version k is a left spine with values 1 ... k
+    constexpr int versions = 300;
+    PersistentTree<int, 8> tree;
+    tree.SetRoot(1);
+    std::atomic<bool> done(false);
+
+    auto reader = [&tree, &done]() {
+        int last = 0;
+        while (not done.load()) {
+            const auto s = tree.Read();
+            auto c = s.Root();
+            const int weight = WeightRecursive(c);
+            int expected = 1;
+            while (true) {
+                EXPECT_EQ(*c, expected);
+                if (not c.HasLeftSuccessor())
+                    break;
+                c = c.LeftSuccessor();
+                ++expected;
+            }
+            EXPECT_EQ(weight, expected);
+            EXPECT_GE(weight, last);
+            last = weight;
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+        readers.emplace_back(reader);
+
+    Path path;
+    for (int k = 2; k <= versions; ++k) {
+        tree.AddLeftSuccessor(path, k);
+        path.push_back(Direction::LEFT);
+    }
+    done.store(true);
+    for (auto& r : readers)
+        r.join();
+
+    EXPECT_EQ(WeightRecursive(tree.Read().Root()), versions);
+    EXPECT_EQ(HeightRecursive(tree.Read().Root()), versions);
+}
+}
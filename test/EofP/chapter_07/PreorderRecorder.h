@@ -0,0 +1,18 @@
+#pragma once
+
+#include "EofP/chapter_07/CoordinateStructures.h"
+
+#include <vector>
+
+namespace EofP {
+
+// Traversal procedure collecting the values in preorder
+template <typename C>
+struct PreorderRecorder {
+    void operator()(Visit visit, C c) {
+        if (visit == Visit::PRE)
+            values.push_back(*c);
+    }
+    std::vector<typename C::Type> values;
+};
+}
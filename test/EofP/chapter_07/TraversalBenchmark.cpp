@@ -0,0 +1,71 @@
+// Times the traversals of a large tree whose nodes are allocated in random
+// order with respect to the tree, so that following a successor is a cache
+// miss. Not a unit test: run it by hand, optionally passing the node count.
+
+#include "EofP/chapter_07/CoordinateStructures.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace EofP;
+
+namespace {
+// each node is attached to an open successor slot drawn at random
+BinaryNode<int> random_tree(std::size_t n, std::mt19937& gen) {
+    BinaryNode<int> root(0);
+    std::vector<std::pair<BinaryNode<int>*, bool>> slots = { { &root, false }, { &root, true } };
+    for (std::size_t i = 1; i < n; ++i) {
+        std::uniform_int_distribution<std::size_t> dis(0, slots.size() - 1);
+        const std::size_t k = dis(gen);
+        const auto [node, right] = slots[k];
+        slots[k] = slots.back();
+        slots.pop_back();
+        auto& child = right ? node->AddRightSuccessor(int(i)) : node->AddLeftSuccessor(int(i));
+        slots.emplace_back(&child, false);
+        slots.emplace_back(&child, true);
+    }
+    return root;
+}
+
+template <typename F>
+void report(const char* name, F f) {
+    long long best = 0;
+    long long sum = 0;
+    for (int k = 0; k < 5; ++k) {
+        const auto start = std::chrono::steady_clock::now();
+        sum = f();
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        if (k == 0 || us < best)
+            best = us;
+    }
+    std::printf("%-28s %8.1f ms  (%lld)\n", name, double(best) / 1000, sum);
+}
+
+struct PreSum {
+    void operator()(Visit v, BifurcateCoordinate<int> c) {
+        if (v == Visit::PRE)
+            sum += *c;
+    }
+    long long sum = 0;
+};
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t(1) << 22;
+    std::mt19937 gen(2024);
+    auto root = random_tree(n, gen);
+    const BifurcateCoordinate<int> c(root);
+    std::printf("%zu nodes, height %d\n", n, HeightRecursive(c));
+
+    report("TraverseNonempty", [c]() { return TraverseNonempty(c, PreSum()).sum; });
+    report("TraverseNonemptyPrefetch", [c]() { return TraverseNonemptyPrefetch(c, PreSum()).sum; });
+    auto sum = [](long long& s) { return [&s](BifurcateCoordinate<int> x, int) { s += *x; }; };
+    report("TraversePrefetch<1>", [c, sum]() { long long s = 0; TraversePrefetch<1>(c, sum(s)); return s; });
+    report("TraversePrefetch<4>", [c, sum]() { long long s = 0; TraversePrefetch<4>(c, sum(s)); return s; });
+    report("TraversePrefetch<8>", [c, sum]() { long long s = 0; TraversePrefetch<8>(c, sum(s)); return s; });
+    report("TraversePrefetch<16>", [c, sum]() { long long s = 0; TraversePrefetch<16>(c, sum(s)); return s; });
+}
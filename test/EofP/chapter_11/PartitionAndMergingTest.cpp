@@ -0,0 +1,64 @@
+#include "EofP/chapter_11/PartitionAndMerging.h"
+#include "EofP/chapter_06/Iterators.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace EofP {
+
+namespace {
+template <typename I>
+auto Value(I i) -> typename std::iterator_traits<I>::value_type {
+    return *i;
+}
+
+int Accumulate(int base, int increment) {
+    return base + increment;
+}
+
+double Add(double x, double y) {
+    return x + y;
+}
+
+std::string Concatenate(const std::string& x, const std::string& y) {
+    return x + y;
+}
+}
+
+TEST(PartitionAndMergingTest, add_to_counter_carries) {
+    std::vector<int> counter = { 1, 2, 0, 4 };
+    EXPECT_EQ(AddToCounter(begin(counter), end(counter), Accumulate, 10, 0), 0);
+    EXPECT_EQ(counter, std::vector<int>({ 0, 0, 13, 4 }));
+    EXPECT_EQ(AddToCounter(begin(counter), end(counter), Accumulate, 0, 0), 0);
+    EXPECT_EQ(counter, std::vector<int>({ 0, 0, 13, 4 }));
+    EXPECT_EQ(ReduceCounter(begin(counter), end(counter), Accumulate, 0), 17);
+}
+
+TEST(PartitionAndMergingTest, reduce_balanced_int) {
+    for (int n = 0; n < 100; ++n) {
+        std::vector<int> v(n);
+        std::iota(begin(v), end(v), 1);
+        EXPECT_EQ(ReduceBalanced(begin(v), end(v), Accumulate, Value<std::vector<int>::iterator>, 0), n * (n + 1) / 2) << n;
+    }
+}
+
+TEST(PartitionAndMergingTest, reduce_balanced_preserves_order) {
+    const std::vector<std::string> v = { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k" };
+    EXPECT_EQ(ReduceBalanced(begin(v), end(v), Concatenate, Value<std::vector<std::string>::const_iterator>, std::string()),
+          "abcdefghijk");
+}
+
+TEST(PartitionAndMergingTest, reduce_balanced_is_more_accurate_than_left_fold) {
+    const std::vector<double> v(1000000, 0.1);
+    const double exact = 100000.0;
+    using It = std::vector<double>::const_iterator;
+    const double left = Reduce(begin(v), end(v), Add, Value<It>, 0.0);
+    const double balanced = ReduceBalanced(begin(v), end(v), Add, Value<It>, 0.0);
+
+    EXPECT_LT(std::abs(balanced - exact), std::abs(left - exact));
+}
+}